@@ -0,0 +1,515 @@
+//Created by sphc on 2026/10/19
+//ExternalSort.h
+//
+
+#ifndef SP_EXTERNAL_SORT__H
+#define SP_EXTERNAL_SORT__H
+
+#include <cstddef> //size_t
+#include <cerrno> //errno, EINTR
+#include <functional> //less
+#include <future> //async, future
+#include <memory> //shared_ptr, unique_ptr
+#include <string> //string
+#include <system_error> //system_error
+#include <type_traits> //is_trivially_copyable
+#include <fcntl.h> //open, posix_fadvise
+#include <stdlib.h> //mkstemp
+#include <unistd.h> //pread, pwrite, close, unlink
+#include "Vector.h"
+#include "Sort.h"
+
+namespace sp {
+
+    struct ExternalSortOptions {
+        std::size_t memoryElements = std::size_t{1} << 24; //elements sorted in memory per run
+        std::size_t maxFanIn = 128; //runs merged in one pass
+        std::string tempDir = "/tmp"; //where runs are spilled
+    };
+
+    //reads trivially copyable T from a file, in bulk
+    template <typename T>
+    class FileSource {
+    public:
+        explicit FileSource(const std::string &path);
+        FileSource(const FileSource &) = delete;
+        FileSource &operator = (const FileSource &) = delete;
+        ~FileSource();
+
+        //reads up to count elements into dst, returns how many were read
+        std::size_t read(T *dst, std::size_t count);
+        //appends up to count elements to buffer, returns how many were appended
+        template <typename Allocator>
+        std::size_t append_to(Vector<T, Allocator> &buffer, std::size_t count);
+        bool operator () (T &value)
+        { return read(&value, 1) == 1; }
+
+    private:
+        int fd;
+        off_t offset;
+    };
+
+    //writes trivially copyable T to a file, truncating it
+    template <typename T>
+    class FileSink {
+    public:
+        explicit FileSink(const std::string &path)
+            : path{path}
+        { }
+
+        const std::string &name() const
+        { return path; }
+
+    private:
+        std::string path;
+    };
+
+    namespace detail {
+
+        inline void throw_errno(const char *what)
+        { throw std::system_error{errno, std::generic_category(), what}; }
+
+        //reads until bytes are read or end of file, returns bytes read
+        inline std::size_t read_full(int fd, void *buf, std::size_t bytes, off_t offset)
+        {
+            char *p = static_cast<char *>(buf);
+            std::size_t done = 0;
+            while (done < bytes) {
+                ssize_t n = ::pread(fd, p + done, bytes - done, offset + static_cast<off_t>(done));
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw_errno("sp::external_sort: pread");
+                }
+                if (n == 0) {
+                    break;
+                }
+                done += static_cast<std::size_t>(n);
+            }
+            return done;
+        }
+
+        inline void write_full(int fd, const void *buf, std::size_t bytes, off_t offset)
+        {
+            const char *p = static_cast<const char *>(buf);
+            std::size_t done = 0;
+            while (done < bytes) {
+                ssize_t n = ::pwrite(fd, p + done, bytes - done, offset + static_cast<off_t>(done));
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw_errno("sp::external_sort: pwrite");
+                }
+                done += static_cast<std::size_t>(n);
+            }
+        }
+
+        //anonymous spill file, unlinked as soon as it is created
+        class TempFile {
+        public:
+            explicit TempFile(const std::string &dir)
+            {
+                std::string name = dir + "/spsort.XXXXXX";
+                fd = ::mkstemp(&name[0]);
+                if (fd < 0) {
+                    throw_errno("sp::external_sort: mkstemp");
+                }
+                ::unlink(name.c_str());
+            }
+
+            TempFile(const TempFile &) = delete;
+            TempFile &operator = (const TempFile &) = delete;
+
+            ~TempFile()
+            { ::close(fd); }
+
+            int get() const noexcept
+            { return fd; }
+
+        private:
+            int fd;
+        };
+
+        struct Run {
+            std::shared_ptr<TempFile> file;
+            off_t offset;
+            std::size_t count;
+        };
+
+        //double-buffered sequential reader: while one block is consumed the next is read in the background
+        template <typename T>
+        class RunReader {
+        public:
+            void open(const Run &run, std::size_t blockElements)
+            {
+                fd = run.file->get();
+                offset = run.offset;
+                remaining = run.count;
+                block = blockElements;
+                current.resize(block);
+                next.resize(block);
+                ::posix_fadvise(fd, offset, static_cast<off_t>(remaining * sizeof(T)), POSIX_FADV_SEQUENTIAL);
+
+                prefetch();
+                advance();
+            }
+
+            bool empty() const noexcept
+            { return pos == avail; }
+
+            const T &front() const
+            { return current[pos]; }
+
+            void pop()
+            {
+                if (++pos == avail) {
+                    advance();
+                }
+            }
+
+        private:
+            int fd;
+            off_t offset;
+            std::size_t remaining;
+            std::size_t block;
+            std::size_t pos = 0;
+            std::size_t avail = 0;
+            Vector<T> current;
+            Vector<T> next;
+            std::future<std::size_t> pending;
+
+            void prefetch()
+            {
+                if (remaining == 0) {
+                    return;
+                }
+                std::size_t count = remaining < block ? remaining : block;
+                off_t at = offset;
+                T *dst = next.data();
+                int file = fd;
+                offset += static_cast<off_t>(count * sizeof(T));
+                remaining -= count;
+                pending = std::async(std::launch::async, [file, dst, count, at] {
+                    return read_full(file, dst, count * sizeof(T), at) / sizeof(T);
+                });
+            }
+
+            void advance()
+            {
+                pos = avail = 0;
+                if (pending.valid()) {
+                    avail = pending.get();
+                    current.swap(next);
+                    prefetch();
+                }
+            }
+        };
+
+        //double-buffered writer: one block fills while the previous one is written in the background
+        template <typename T>
+        class RunWriter {
+        public:
+            RunWriter(int fd, off_t offset, std::size_t blockElements)
+                : fd{fd}, offset{offset}, block{blockElements}
+            {
+                current.reserve(block);
+                next.reserve(block);
+            }
+
+            RunWriter(const RunWriter &) = delete;
+            RunWriter &operator = (const RunWriter &) = delete;
+
+            void push(const T &value)
+            {
+                current.push_back(value);
+                if (current.size() == block) {
+                    flush_block();
+                }
+            }
+
+            //flushes everything and returns the offset past the last element written
+            off_t finish()
+            {
+                flush_block();
+                wait();
+                return offset;
+            }
+
+        private:
+            int fd;
+            off_t offset;
+            std::size_t block;
+            Vector<T> current;
+            Vector<T> next;
+            std::future<void> pending;
+
+            void wait()
+            {
+                if (pending.valid()) {
+                    pending.get();
+                }
+            }
+
+            void flush_block()
+            {
+                if (current.empty()) {
+                    return;
+                }
+                wait();
+                current.swap(next);
+                current.clear();
+
+                const T *src = next.data();
+                std::size_t bytes = next.size() * sizeof(T);
+                off_t at = offset;
+                int file = fd;
+                offset += static_cast<off_t>(bytes);
+                pending = std::async(std::launch::async, [file, src, bytes, at] {
+                    write_full(file, src, bytes, at);
+                });
+            }
+        };
+
+        template <typename T, typename Allocator>
+        class VectorOutput {
+        public:
+            explicit VectorOutput(Vector<T, Allocator> &out)
+                : out{out}
+            { }
+
+            void push(const T &value)
+            { out.push_back(value); }
+
+        private:
+            Vector<T, Allocator> &out;
+        };
+
+        //fills buffer with at most limit elements, returns false once the source is exhausted
+        template <typename T, typename Allocator, typename Producer>
+        bool fill_run(Producer &producer, Vector<T, Allocator> &buffer, std::size_t limit)
+        {
+            T value;
+            while (buffer.size() < limit && producer(value)) {
+                buffer.push_back(value);
+            }
+            return buffer.size() == limit;
+        }
+
+        template <typename T, typename Allocator>
+        bool fill_run(FileSource<T> &source, Vector<T, Allocator> &buffer, std::size_t limit)
+        {
+            source.append_to(buffer, limit - buffer.size());
+            return buffer.size() == limit;
+        }
+
+        //k-way merge through a binary heap of reader indices
+        template <typename T, typename Output, typename Compare>
+        void merge_runs(const Run *runs, std::size_t k, Output &out, std::size_t blockElements, Compare comp)
+        {
+            std::unique_ptr<RunReader<T>[]> readers{new RunReader<T>[k]};
+            Vector<std::size_t> heap;
+            heap.reserve(k);
+
+            auto less = [&readers, &comp](std::size_t a, std::size_t b) {
+                return comp(readers[a].front(), readers[b].front());
+            };
+            auto sift_down = [&heap, &less](std::size_t hole) {
+                std::size_t n = heap.size(), top = heap[hole], child;
+                while ((child = 2 * hole + 1) < n) {
+                    if (child + 1 < n && less(heap[child + 1], heap[child])) {
+                        ++child;
+                    }
+                    if (!less(heap[child], top)) {
+                        break;
+                    }
+                    heap[hole] = heap[child];
+                    hole = child;
+                }
+                heap[hole] = top;
+            };
+
+            for (std::size_t i = 0; i < k; ++i) {
+                readers[i].open(runs[i], blockElements);
+                if (!readers[i].empty()) {
+                    heap.push_back(i);
+                }
+            }
+            for (std::size_t i = heap.size() / 2; i-- > 0; ) {
+                sift_down(i);
+            }
+
+            while (!heap.empty()) {
+                RunReader<T> &reader = readers[heap[0]];
+                out.push(reader.front());
+                reader.pop();
+                if (reader.empty()) {
+                    heap[0] = heap.back();
+                    heap.pop_back();
+                }
+                if (!heap.empty()) {
+                    sift_down(0);
+                }
+            }
+        }
+
+        inline std::size_t merge_block(const ExternalSortOptions &options, std::size_t k)
+        {
+            std::size_t block = options.memoryElements / (2 * (k + 1));
+            return block < 1024 ? 1024 : block;
+        }
+
+        //sorts runs of options.memoryElements, spills them and merges until at most maxFanIn remain;
+        //returns false if the whole input fit in buffer, which is then sorted in place
+        template <typename T, typename Source, typename Compare>
+        bool make_runs(Source &source, Vector<T> &buffer, Vector<Run> &runs,
+                       const ExternalSortOptions &options, Compare comp)
+        {
+            std::size_t limit = options.memoryElements ? options.memoryElements : 1;
+            buffer.reserve(limit);
+
+            bool more = fill_run(source, buffer, limit);
+            sp::sort(buffer, comp);
+            if (!more) {
+                return false;
+            }
+
+            std::shared_ptr<TempFile> spill = std::make_shared<TempFile>(options.tempDir);
+            off_t offset = 0;
+            while (!buffer.empty()) {
+                write_full(spill->get(), buffer.data(), buffer.size() * sizeof(T), offset);
+                runs.push_back(Run{spill, offset, buffer.size()});
+                offset += static_cast<off_t>(buffer.size() * sizeof(T));
+
+                buffer.clear();
+                more = more && fill_run(source, buffer, limit);
+                sp::sort(buffer, comp);
+            }
+            buffer.clear();
+            buffer.shrink_to_fit();
+
+            std::size_t fanIn = options.maxFanIn < 2 ? 2 : options.maxFanIn;
+            while (runs.size() > fanIn) {
+                Vector<Run> merged;
+                std::shared_ptr<TempFile> file = std::make_shared<TempFile>(options.tempDir);
+                off_t at = 0;
+                for (std::size_t first = 0; first < runs.size(); first += fanIn) {
+                    std::size_t k = runs.size() - first < fanIn ? runs.size() - first : fanIn;
+                    std::size_t count = 0;
+                    for (std::size_t i = first; i < first + k; ++i) {
+                        count += runs[i].count;
+                    }
+                    std::size_t block = merge_block(options, k);
+                    RunWriter<T> writer{file->get(), at, block};
+                    merge_runs<T>(runs.data() + first, k, writer, block, comp);
+                    merged.push_back(Run{file, at, count});
+                    at = writer.finish();
+                }
+                runs.swap(merged);
+            }
+            return true;
+        }
+
+    } //namespace detail
+
+    template <typename T>
+    FileSource<T>::FileSource(const std::string &path)
+        : fd{::open(path.c_str(), O_RDONLY)}, offset{0}
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "FileSource requires a trivially copyable type");
+        if (fd < 0) {
+            detail::throw_errno("sp::FileSource: open");
+        }
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    template <typename T>
+    FileSource<T>::~FileSource()
+    { ::close(fd); }
+
+    template <typename T>
+    std::size_t FileSource<T>::read(T *dst, std::size_t count)
+    {
+        std::size_t bytes = detail::read_full(fd, dst, count * sizeof(T), offset);
+        offset += static_cast<off_t>(bytes);
+        return bytes / sizeof(T);
+    }
+
+    template <typename T>
+    template <typename Allocator>
+    std::size_t FileSource<T>::append_to(Vector<T, Allocator> &buffer, std::size_t count)
+    {
+        if (::lseek(fd, offset, SEEK_SET) < 0) {
+            detail::throw_errno("sp::FileSource: lseek");
+        }
+        std::size_t appended = buffer.append_from_fd(fd, count * sizeof(T));
+        offset += static_cast<off_t>(appended * sizeof(T));
+        return appended;
+    }
+
+    //sorts everything source produces into out; source is a FileSource<T> or a callable
+    //bool(T &) returning false when exhausted
+    template <typename T, typename Allocator, typename Source, typename Compare = std::less<T>>
+    void external_sort(Source &&source, Vector<T, Allocator> &out,
+                       const ExternalSortOptions &options = ExternalSortOptions{}, Compare comp = Compare{})
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "external_sort requires a trivially copyable type");
+
+        Vector<T> buffer;
+        Vector<detail::Run> runs;
+        out.clear();
+
+        if (!detail::make_runs(source, buffer, runs, options, comp)) {
+            out.reserve(buffer.size());
+            for (const T &x : buffer) {
+                out.push_back(x);
+            }
+            return;
+        }
+
+        std::size_t total = 0;
+        for (const detail::Run &run : runs) {
+            total += run.count;
+        }
+        out.reserve(total);
+        detail::VectorOutput<T, Allocator> output{out};
+        detail::merge_runs<T>(runs.data(), runs.size(), output, detail::merge_block(options, runs.size()), comp);
+    }
+
+    //sorts everything source produces into the file named by sink
+    template <typename T, typename Source, typename Compare = std::less<T>>
+    void external_sort(Source &&source, const FileSink<T> &sink,
+                       const ExternalSortOptions &options = ExternalSortOptions{}, Compare comp = Compare{})
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "external_sort requires a trivially copyable type");
+
+        Vector<T> buffer;
+        Vector<detail::Run> runs;
+        bool spilled = detail::make_runs(source, buffer, runs, options, comp);
+
+        int fd = ::open(sink.name().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            detail::throw_errno("sp::external_sort: open");
+        }
+        try {
+            if (!spilled) {
+                detail::write_full(fd, buffer.data(), buffer.size() * sizeof(T), 0);
+            }
+            else {
+                std::size_t block = detail::merge_block(options, runs.size());
+                detail::RunWriter<T> writer{fd, 0, block};
+                detail::merge_runs<T>(runs.data(), runs.size(), writer, block, comp);
+                writer.finish();
+            }
+        }
+        catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+    }
+
+} //namespace sp
+
+#endif //SP_EXTERNAL_SORT__H
@@ -0,0 +1,499 @@
+//Created by sphc on 2026/10/19
+//FlatMap.h
+//
+
+#ifndef SP_FLAT_MAP__H
+#define SP_FLAT_MAP__H
+
+#include <algorithm> //equal
+#include <cstddef> //size_t, ptrdiff_t
+#include <functional> //less
+#include <initializer_list> //initializer_list
+#include <iterator> //random_access_iterator_tag
+#include <memory> //allocator, allocator_traits
+#include <stdexcept> //out_of_range
+#include <type_traits> //conditional, enable_if
+#include <utility> //pair, move, move_if_noexcept, swap
+#include "Vector.h"
+#include "Span.h"
+#include "Sort.h"
+#include "FlatSet.h"
+
+namespace sp {
+
+    //map with unique keys kept sorted in one Vector and the mapped values, in the same order, in
+    //a second one: searches only touch keys, so more of them share a cache line. Dereferencing
+    //an iterator gives a pair of references. Like FlatSet, fill it in bulk.
+    template <typename Key, typename T, typename Compare = std::less<Key>,
+              typename Allocator = std::allocator<std::pair<const Key, T>>,
+              FlatSearch Search = FlatSearch::branchless>
+    class FlatMap {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key, T> value_type;
+        typedef Compare key_compare;
+        typedef Allocator allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::pair<const Key &, T &> reference;
+        typedef std::pair<const Key &, const T &> const_reference;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Key> key_allocator_type;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<T> mapped_allocator_type;
+
+        template <bool Const>
+        class Iterator {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef FlatMap::value_type value_type;
+            typedef FlatMap::difference_type difference_type;
+            typedef typename std::conditional<Const, const_reference, FlatMap::reference>::type reference;
+
+            //operator -> hands out the pair of references by value
+            struct pointer {
+                reference ref;
+
+                const reference *operator -> () const
+                { return &ref; }
+            };
+
+            Iterator(const Key *key, typename std::conditional<Const, const T *, T *>::type mapped)
+                : key{key}, mapped{mapped}
+            { }
+
+            //iterator converts to const_iterator
+            template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+            Iterator(const Iterator<OtherConst> &other)
+                : key{other.key}, mapped{other.mapped}
+            { }
+
+            reference operator * () const
+            { return reference{*key, *mapped}; }
+
+            pointer operator -> () const
+            { return pointer{**this}; }
+
+            reference operator [] (difference_type step) const
+            { return reference{key[step], mapped[step]}; }
+
+            Iterator &operator ++ ()
+            {
+                ++key;
+                ++mapped;
+                return *this;
+            }
+
+            Iterator operator ++ (int)
+            {
+                Iterator old = *this;
+                ++*this;
+                return old;
+            }
+
+            Iterator &operator -- ()
+            {
+                --key;
+                --mapped;
+                return *this;
+            }
+
+            Iterator operator -- (int)
+            {
+                Iterator old = *this;
+                --*this;
+                return old;
+            }
+
+            Iterator operator + (difference_type step) const
+            { return Iterator{key + step, mapped + step}; }
+
+            Iterator operator - (difference_type step) const
+            { return Iterator{key - step, mapped - step}; }
+
+            difference_type operator - (const Iterator &other) const
+            { return key - other.key; }
+
+            bool operator == (const Iterator &other) const
+            { return key == other.key; }
+
+            bool operator != (const Iterator &other) const
+            { return key != other.key; }
+
+            bool operator < (const Iterator &other) const
+            { return key < other.key; }
+
+        private:
+            friend class FlatMap;
+            template <bool> friend class Iterator;
+
+            const Key *key;
+            typename std::conditional<Const, const T *, T *>::type mapped;
+        };
+
+        typedef Iterator<false> iterator;
+        typedef Iterator<true> const_iterator;
+
+        //constructor
+        explicit FlatMap(const key_compare &comp = key_compare{}, const allocator_type &allocator = allocator_type{});
+        template <typename InputIterator>
+        FlatMap(InputIterator first, InputIterator last,
+                const key_compare &comp = key_compare{}, const allocator_type &allocator = allocator_type{});
+        FlatMap(std::initializer_list<value_type> ilist,
+                const key_compare &comp = key_compare{}, const allocator_type &allocator = allocator_type{});
+
+        //access element
+        mapped_type &at(const key_type &key);
+        const mapped_type &at(const key_type &key) const;
+        mapped_type &operator [] (const key_type &key);
+
+        //iterator
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+        //capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+        void reserve(size_type newCapacity);
+        void shrink_to_fit();
+
+        //lookup
+        iterator find(const key_type &key);
+        const_iterator find(const key_type &key) const;
+        bool contains(const key_type &key) const;
+        size_type count(const key_type &key) const;
+        iterator lower_bound(const key_type &key);
+        const_iterator lower_bound(const key_type &key) const;
+        iterator upper_bound(const key_type &key);
+        const_iterator upper_bound(const key_type &key) const;
+
+        //update
+        std::pair<iterator, bool> insert(const value_type &value);
+        std::pair<iterator, bool> insert_or_assign(const key_type &key, const mapped_type &value);
+        //appends the range, sorts it by key and merges it with the present entries in one pass;
+        //entries whose key is already present, and later repeats of a key within the range, are
+        //skipped, as std::map::insert would
+        template <typename InputIterator>
+        void insert(InputIterator first, InputIterator last);
+        void insert(std::initializer_list<value_type> ilist);
+        iterator erase(const_iterator pos);
+        size_type erase(const key_type &key);
+        void clear() noexcept;
+        void swap(FlatMap &other);
+
+        //observer: the two arrays, index i of one belongs to index i of the other
+        Span<const key_type> keys() const noexcept;
+        Span<mapped_type> values() noexcept;
+        Span<const mapped_type> values() const noexcept;
+        key_compare key_comp() const;
+        allocator_type get_allocator() const;
+
+    private:
+        detail::FlatKeys<Key, Compare, key_allocator_type, Search> sorted;
+        Vector<T, mapped_allocator_type> mapped;
+
+        //inserts at index i, which must be where key belongs
+        iterator insert_at(size_type i, const key_type &key, const mapped_type &value);
+    };
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    FlatMap<Key, T, Compare, Allocator, Search>::FlatMap(const key_compare &comp, const allocator_type &allocator)
+        : sorted{comp, key_allocator_type{allocator}}, mapped{mapped_allocator_type{allocator}}
+    { }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    template <typename InputIterator>
+    FlatMap<Key, T, Compare, Allocator, Search>::FlatMap(InputIterator first, InputIterator last,
+                                                         const key_compare &comp, const allocator_type &allocator)
+        : FlatMap(comp, allocator)
+    { insert(first, last); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    FlatMap<Key, T, Compare, Allocator, Search>::FlatMap(std::initializer_list<value_type> ilist,
+                                                         const key_compare &comp, const allocator_type &allocator)
+        : FlatMap(comp, allocator)
+    { insert(ilist.begin(), ilist.end()); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::mapped_type &FlatMap<Key, T, Compare, Allocator, Search>::at(const key_type &key)
+    {
+        size_type i = sorted.find(key);
+        if (i == size()) {
+            throw std::out_of_range{"sp::FlatMap::at"};
+        }
+        return mapped[i];
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    const typename FlatMap<Key, T, Compare, Allocator, Search>::mapped_type &FlatMap<Key, T, Compare, Allocator, Search>::at(const key_type &key) const
+    {
+        size_type i = sorted.find(key);
+        if (i == size()) {
+            throw std::out_of_range{"sp::FlatMap::at"};
+        }
+        return mapped[i];
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::mapped_type &FlatMap<Key, T, Compare, Allocator, Search>::operator [] (const key_type &key)
+    {
+        size_type i = sorted.lower_bound(key);
+        if (i == size() || sorted.comp(key, sorted.keys[i])) {
+            insert_at(i, key, mapped_type{});
+        }
+        return mapped[i];
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::iterator FlatMap<Key, T, Compare, Allocator, Search>::begin() noexcept
+    { return iterator{sorted.keys.data(), mapped.data()}; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::iterator FlatMap<Key, T, Compare, Allocator, Search>::end() noexcept
+    { return begin() + static_cast<difference_type>(size()); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::const_iterator FlatMap<Key, T, Compare, Allocator, Search>::begin() const noexcept
+    { return const_iterator{sorted.keys.data(), mapped.data()}; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::const_iterator FlatMap<Key, T, Compare, Allocator, Search>::end() const noexcept
+    { return begin() + static_cast<difference_type>(size()); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::const_iterator FlatMap<Key, T, Compare, Allocator, Search>::cbegin() const noexcept
+    { return begin(); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::const_iterator FlatMap<Key, T, Compare, Allocator, Search>::cend() const noexcept
+    { return end(); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    bool FlatMap<Key, T, Compare, Allocator, Search>::empty() const noexcept
+    { return sorted.keys.empty(); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::size_type FlatMap<Key, T, Compare, Allocator, Search>::size() const noexcept
+    { return sorted.keys.size(); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatMap<Key, T, Compare, Allocator, Search>::reserve(size_type newCapacity)
+    {
+        sorted.keys.reserve(newCapacity);
+        mapped.reserve(newCapacity);
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatMap<Key, T, Compare, Allocator, Search>::shrink_to_fit()
+    {
+        sorted.keys.shrink_to_fit();
+        mapped.shrink_to_fit();
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::iterator FlatMap<Key, T, Compare, Allocator, Search>::find(const key_type &key)
+    { return begin() + static_cast<difference_type>(sorted.find(key)); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::const_iterator FlatMap<Key, T, Compare, Allocator, Search>::find(const key_type &key) const
+    { return begin() + static_cast<difference_type>(sorted.find(key)); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    bool FlatMap<Key, T, Compare, Allocator, Search>::contains(const key_type &key) const
+    { return sorted.find(key) != size(); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::size_type FlatMap<Key, T, Compare, Allocator, Search>::count(const key_type &key) const
+    { return contains(key) ? 1 : 0; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::iterator FlatMap<Key, T, Compare, Allocator, Search>::lower_bound(const key_type &key)
+    { return begin() + static_cast<difference_type>(sorted.lower_bound(key)); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::const_iterator FlatMap<Key, T, Compare, Allocator, Search>::lower_bound(const key_type &key) const
+    { return begin() + static_cast<difference_type>(sorted.lower_bound(key)); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::iterator FlatMap<Key, T, Compare, Allocator, Search>::upper_bound(const key_type &key)
+    { return begin() + static_cast<difference_type>(sorted.upper_bound(key)); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::const_iterator FlatMap<Key, T, Compare, Allocator, Search>::upper_bound(const key_type &key) const
+    { return begin() + static_cast<difference_type>(sorted.upper_bound(key)); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    std::pair<typename FlatMap<Key, T, Compare, Allocator, Search>::iterator, bool>
+    FlatMap<Key, T, Compare, Allocator, Search>::insert(const value_type &value)
+    {
+        size_type i = sorted.lower_bound(value.first);
+        if (i < size() && !sorted.comp(value.first, sorted.keys[i])) {
+            return {begin() + static_cast<difference_type>(i), false};
+        }
+        return {insert_at(i, value.first, value.second), true};
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    std::pair<typename FlatMap<Key, T, Compare, Allocator, Search>::iterator, bool>
+    FlatMap<Key, T, Compare, Allocator, Search>::insert_or_assign(const key_type &key, const mapped_type &value)
+    {
+        size_type i = sorted.lower_bound(key);
+        if (i < size() && !sorted.comp(key, sorted.keys[i])) {
+            mapped[i] = value;
+            return {begin() + static_cast<difference_type>(i), false};
+        }
+        return {insert_at(i, key, value), true};
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    template <typename InputIterator>
+    void FlatMap<Key, T, Compare, Allocator, Search>::insert(InputIterator first, InputIterator last)
+    {
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<value_type> entry_allocator_type;
+        Vector<value_type, entry_allocator_type> incoming{entry_allocator_type{get_allocator()}};
+        for (; first != last; ++first) {
+            incoming.push_back(value_type(*first));
+        }
+        if (incoming.empty()) {
+            return;
+        }
+        const Compare &comp = sorted.comp;
+        stable_sort(incoming, [&comp](const value_type &a, const value_type &b) { return comp(a.first, b.first); });
+
+        Vector<Key, key_allocator_type> &keys = sorted.keys;
+        //all new keys sort after the present ones, e.g. building from sorted input: just append
+        if (keys.empty() || comp(keys.back(), incoming.front().first)) {
+            keys.reserve(keys.size() + incoming.size());
+            mapped.reserve(keys.size() + incoming.size());
+            for (size_type j = 0; j < incoming.size(); ++j) {
+                if (keys.empty() || comp(keys.back(), incoming[j].first)) {
+                    keys.push_back(std::move(incoming[j].first));
+                    mapped.push_back(std::move(incoming[j].second));
+                }
+            }
+            sorted.reindex();
+            return;
+        }
+
+        Vector<Key, key_allocator_type> mergedKeys{keys.get_allocator()};
+        Vector<T, mapped_allocator_type> mergedValues{mapped.get_allocator()};
+        mergedKeys.reserve(keys.size() + incoming.size());
+        mergedValues.reserve(keys.size() + incoming.size());
+        size_type i = 0, j = 0;
+        while (j < incoming.size()) {
+            if (i < keys.size() && comp(keys[i], incoming[j].first)) {
+                mergedKeys.push_back(std::move_if_noexcept(keys[i]));
+                mergedValues.push_back(std::move_if_noexcept(mapped[i++]));
+            }
+            else if ((i < keys.size() && !comp(incoming[j].first, keys[i]))
+                     || (!mergedKeys.empty() && !comp(mergedKeys.back(), incoming[j].first))) {
+                ++j; //already present, or a repeat within the range
+            }
+            else {
+                mergedKeys.push_back(std::move(incoming[j].first));
+                mergedValues.push_back(std::move(incoming[j++].second));
+            }
+        }
+        for (; i < keys.size(); ++i) {
+            mergedKeys.push_back(std::move_if_noexcept(keys[i]));
+            mergedValues.push_back(std::move_if_noexcept(mapped[i]));
+        }
+        keys.swap(mergedKeys);
+        mapped.swap(mergedValues);
+        sorted.reindex();
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatMap<Key, T, Compare, Allocator, Search>::insert(std::initializer_list<value_type> ilist)
+    { insert(ilist.begin(), ilist.end()); }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::iterator FlatMap<Key, T, Compare, Allocator, Search>::erase(const_iterator pos)
+    {
+        difference_type i = pos.key - sorted.keys.data();
+        sorted.keys.erase(sorted.keys.begin() + i);
+        mapped.erase(mapped.begin() + i);
+        sorted.reindex();
+        return begin() + i;
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::size_type FlatMap<Key, T, Compare, Allocator, Search>::erase(const key_type &key)
+    {
+        size_type i = sorted.find(key);
+        if (i == size()) {
+            return 0;
+        }
+        erase(cbegin() + static_cast<difference_type>(i));
+        return 1;
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatMap<Key, T, Compare, Allocator, Search>::clear() noexcept
+    {
+        sorted.keys.clear();
+        mapped.clear();
+        sorted.reindex();
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatMap<Key, T, Compare, Allocator, Search>::swap(FlatMap &other)
+    {
+        std::swap(sorted, other.sorted);
+        mapped.swap(other.mapped);
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    Span<const typename FlatMap<Key, T, Compare, Allocator, Search>::key_type> FlatMap<Key, T, Compare, Allocator, Search>::keys() const noexcept
+    { return Span<const key_type>{sorted.keys.data(), sorted.keys.size()}; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    Span<typename FlatMap<Key, T, Compare, Allocator, Search>::mapped_type> FlatMap<Key, T, Compare, Allocator, Search>::values() noexcept
+    { return Span<mapped_type>{mapped.data(), mapped.size()}; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    Span<const typename FlatMap<Key, T, Compare, Allocator, Search>::mapped_type> FlatMap<Key, T, Compare, Allocator, Search>::values() const noexcept
+    { return Span<const mapped_type>{mapped.data(), mapped.size()}; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::key_compare FlatMap<Key, T, Compare, Allocator, Search>::key_comp() const
+    { return sorted.comp; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::allocator_type FlatMap<Key, T, Compare, Allocator, Search>::get_allocator() const
+    { return allocator_type{sorted.keys.get_allocator()}; }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatMap<Key, T, Compare, Allocator, Search>::iterator
+    FlatMap<Key, T, Compare, Allocator, Search>::insert_at(size_type i, const key_type &key, const mapped_type &value)
+    {
+        mapped.insert(mapped.begin() + i, value);
+        try {
+            sorted.keys.insert(sorted.keys.begin() + i, key);
+        }
+        catch (...) {
+            mapped.erase(mapped.begin() + i);
+            throw;
+        }
+        sorted.reindex();
+        return begin() + static_cast<difference_type>(i);
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    bool operator == (const FlatMap<Key, T, Compare, Allocator, Search> &lhs, const FlatMap<Key, T, Compare, Allocator, Search> &rhs)
+    {
+        Span<const Key> a = lhs.keys(), b = rhs.keys();
+        Span<const T> x = lhs.values(), y = rhs.values();
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin()) && std::equal(x.begin(), x.end(), y.begin());
+    }
+
+    template <typename Key, typename T, typename Compare, typename Allocator, FlatSearch Search>
+    bool operator != (const FlatMap<Key, T, Compare, Allocator, Search> &lhs, const FlatMap<Key, T, Compare, Allocator, Search> &rhs)
+    { return !(lhs == rhs); }
+
+} //namespace sp
+
+#endif //SP_FLAT_MAP__H
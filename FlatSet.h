@@ -0,0 +1,430 @@
+//Created by sphc on 2026/10/19
+//FlatSet.h
+//
+
+#ifndef SP_FLAT_SET__H
+#define SP_FLAT_SET__H
+
+#include <algorithm> //partition_point, equal
+#include <cstddef> //size_t, ptrdiff_t
+#include <functional> //less
+#include <initializer_list> //initializer_list
+#include <memory> //allocator
+#include <type_traits> //conditional
+#include <utility> //pair, move, move_if_noexcept, swap
+#include "Vector.h"
+#include "Span.h"
+#include "Sort.h"
+
+namespace sp {
+
+    //how FlatSet and FlatMap look keys up in their sorted key array
+    enum class FlatSearch {
+        binary, //std::partition_point
+        branchless, //halving loop whose only branch is the loop condition
+        eytzinger //extra copy of the keys in breadth-first order, rebuilt on every change
+    };
+
+    namespace detail {
+
+        //lower bound kernels: index of the first element x of [first, first + n) with !before(x)
+        template <typename T, typename Before>
+        std::size_t binary_search_index(const T *first, std::size_t n, Before before)
+        { return static_cast<std::size_t>(std::partition_point(first, first + n, before) - first); }
+
+        //the comparison result scales the step instead of selecting a pointer, which compilers
+        //tend to turn back into a jump; no mispredictions, the loop always runs log2(n) times
+        template <typename T, typename Before>
+        std::size_t branchless_search_index(const T *first, std::size_t n, Before before)
+        {
+            if (n == 0) {
+                return 0;
+            }
+            const T *base = first;
+            while (n > 1) {
+                std::size_t half = n / 2;
+                base += static_cast<std::size_t>(before(base[half])) * half;
+                n -= half;
+            }
+            return static_cast<std::size_t>(base - first) + before(*base);
+        }
+
+        //sorted keys in Eytzinger (breadth-first) order: node k has children 2k and 2k + 1, so the
+        //first levels of every search share cache lines and the next ones can be prefetched.
+        //Nodes are 1-based, node k lives at tree[k - 1] and rank[k - 1] is its sorted index.
+        template <typename Key, typename Allocator>
+        class EytzingerIndex {
+        public:
+            typedef std::size_t size_type;
+
+            explicit EytzingerIndex(const Allocator &allocator)
+                : tree{allocator}
+            { }
+
+            void build(const Key *sorted, size_type n)
+            {
+                rank.assign(n, 0);
+                size_type next = 0;
+                number(1, n, next);
+                tree.clear();
+                tree.reserve(n);
+                for (size_type k = 0; k < n; ++k) {
+                    tree.push_back(sorted[rank[k]]);
+                }
+            }
+
+            template <typename Before>
+            size_type search(Before before) const
+            {
+                size_type n = tree.size(), k = 1;
+                while (k <= n) {
+                    //the 16 great-great-grandchildren of k are adjacent
+                    if (16 * k <= n) {
+                        __builtin_prefetch(tree.data() + 16 * k - 1);
+                    }
+                    k = 2 * k + before(tree[k - 1]);
+                }
+                //strip the right turns taken after the last left turn, that node is the answer
+                k >>= __builtin_ffsll(static_cast<long long>(~k));
+                return k ? rank[k - 1] : n;
+            }
+
+        private:
+            Vector<Key, Allocator> tree;
+            Vector<size_type> rank;
+
+            //in-order walk handing out sorted indices; depth is log2(n)
+            void number(size_type k, size_type n, size_type &next)
+            {
+                if (k <= n) {
+                    number(2 * k, n, next);
+                    rank[k - 1] = next++;
+                    number(2 * k + 1, n, next);
+                }
+            }
+        };
+
+        struct NoIndex {
+            template <typename Allocator>
+            explicit NoIndex(const Allocator &)
+            { }
+        };
+
+        //the sorted key array shared by FlatSet and FlatMap, plus its search strategy
+        template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+        struct FlatKeys {
+            typedef std::size_t size_type;
+            typedef typename std::conditional<Search == FlatSearch::eytzinger,
+                                              EytzingerIndex<Key, Allocator>, NoIndex>::type index_type;
+
+            Vector<Key, Allocator> keys;
+            Compare comp;
+            index_type index;
+
+            FlatKeys(const Compare &comp, const Allocator &allocator)
+                : keys{allocator}, comp{comp}, index{allocator}
+            { }
+
+            template <typename Before>
+            size_type search(Before before) const
+            {
+                if constexpr (Search == FlatSearch::binary) {
+                    return binary_search_index(keys.data(), keys.size(), before);
+                }
+                else if constexpr (Search == FlatSearch::branchless) {
+                    return branchless_search_index(keys.data(), keys.size(), before);
+                }
+                else {
+                    return index.search(before);
+                }
+            }
+
+            size_type lower_bound(const Key &key) const
+            { return search([this, &key](const Key &x) { return comp(x, key); }); }
+
+            size_type upper_bound(const Key &key) const
+            { return search([this, &key](const Key &x) { return !comp(key, x); }); }
+
+            //index of key, or keys.size() if absent
+            size_type find(const Key &key) const
+            {
+                size_type i = lower_bound(key);
+                return i < keys.size() && !comp(key, keys[i]) ? i : keys.size();
+            }
+
+            //call after every change of keys
+            void reindex()
+            {
+                if constexpr (Search == FlatSearch::eytzinger) {
+                    index.build(keys.data(), keys.size());
+                }
+            }
+        };
+
+    } //namespace detail
+
+    //set of unique keys kept in one sorted Vector: lookups touch a dense array instead of chasing
+    //tree nodes. Single inserts and erases move the keys behind them, so fill it in bulk with
+    //insert(first, last) and keep single updates rare.
+    template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>,
+              FlatSearch Search = FlatSearch::branchless>
+    class FlatSet {
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef Compare key_compare;
+        typedef Allocator allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Key &reference;
+        typedef const Key &const_reference;
+        typedef const Key *iterator; //keys are never modified in place
+        typedef const Key *const_iterator;
+
+        //constructor
+        explicit FlatSet(const key_compare &comp = key_compare{}, const allocator_type &allocator = allocator_type{});
+        template <typename InputIterator>
+        FlatSet(InputIterator first, InputIterator last,
+                const key_compare &comp = key_compare{}, const allocator_type &allocator = allocator_type{});
+        FlatSet(std::initializer_list<value_type> ilist,
+                const key_compare &comp = key_compare{}, const allocator_type &allocator = allocator_type{});
+
+        //iterator
+        iterator begin() const noexcept;
+        iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+        //capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+        void reserve(size_type newCapacity);
+        void shrink_to_fit();
+
+        //lookup
+        iterator find(const key_type &key) const;
+        bool contains(const key_type &key) const;
+        size_type count(const key_type &key) const;
+        iterator lower_bound(const key_type &key) const;
+        iterator upper_bound(const key_type &key) const;
+        std::pair<iterator, iterator> equal_range(const key_type &key) const;
+
+        //update
+        std::pair<iterator, bool> insert(const value_type &value);
+        //appends the range, sorts it and merges it with the present keys in one pass; keys
+        //already present, and repeats within the range, are skipped
+        template <typename InputIterator>
+        void insert(InputIterator first, InputIterator last);
+        void insert(std::initializer_list<value_type> ilist);
+        iterator erase(const_iterator pos);
+        size_type erase(const key_type &key);
+        void clear() noexcept;
+        void swap(FlatSet &other);
+
+        //observer
+        Span<const key_type> keys() const noexcept;
+        key_compare key_comp() const;
+        allocator_type get_allocator() const;
+
+    private:
+        detail::FlatKeys<Key, Compare, Allocator, Search> sorted;
+    };
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    FlatSet<Key, Compare, Allocator, Search>::FlatSet(const key_compare &comp, const allocator_type &allocator)
+        : sorted{comp, allocator}
+    { }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    template <typename InputIterator>
+    FlatSet<Key, Compare, Allocator, Search>::FlatSet(InputIterator first, InputIterator last,
+                                                      const key_compare &comp, const allocator_type &allocator)
+        : sorted{comp, allocator}
+    { insert(first, last); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    FlatSet<Key, Compare, Allocator, Search>::FlatSet(std::initializer_list<value_type> ilist,
+                                                      const key_compare &comp, const allocator_type &allocator)
+        : sorted{comp, allocator}
+    { insert(ilist.begin(), ilist.end()); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::iterator FlatSet<Key, Compare, Allocator, Search>::begin() const noexcept
+    { return sorted.keys.data(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::iterator FlatSet<Key, Compare, Allocator, Search>::end() const noexcept
+    { return sorted.keys.data() + sorted.keys.size(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::const_iterator FlatSet<Key, Compare, Allocator, Search>::cbegin() const noexcept
+    { return begin(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::const_iterator FlatSet<Key, Compare, Allocator, Search>::cend() const noexcept
+    { return end(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    bool FlatSet<Key, Compare, Allocator, Search>::empty() const noexcept
+    { return sorted.keys.empty(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::size_type FlatSet<Key, Compare, Allocator, Search>::size() const noexcept
+    { return sorted.keys.size(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatSet<Key, Compare, Allocator, Search>::reserve(size_type newCapacity)
+    { sorted.keys.reserve(newCapacity); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatSet<Key, Compare, Allocator, Search>::shrink_to_fit()
+    { sorted.keys.shrink_to_fit(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::iterator FlatSet<Key, Compare, Allocator, Search>::find(const key_type &key) const
+    { return begin() + sorted.find(key); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    bool FlatSet<Key, Compare, Allocator, Search>::contains(const key_type &key) const
+    { return sorted.find(key) != size(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::size_type FlatSet<Key, Compare, Allocator, Search>::count(const key_type &key) const
+    { return contains(key) ? 1 : 0; }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::iterator FlatSet<Key, Compare, Allocator, Search>::lower_bound(const key_type &key) const
+    { return begin() + sorted.lower_bound(key); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::iterator FlatSet<Key, Compare, Allocator, Search>::upper_bound(const key_type &key) const
+    { return begin() + sorted.upper_bound(key); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    std::pair<typename FlatSet<Key, Compare, Allocator, Search>::iterator, typename FlatSet<Key, Compare, Allocator, Search>::iterator>
+    FlatSet<Key, Compare, Allocator, Search>::equal_range(const key_type &key) const
+    {
+        iterator first = lower_bound(key);
+        return {first, first != end() && !sorted.comp(key, *first) ? first + 1 : first};
+    }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    std::pair<typename FlatSet<Key, Compare, Allocator, Search>::iterator, bool>
+    FlatSet<Key, Compare, Allocator, Search>::insert(const value_type &value)
+    {
+        size_type i = sorted.lower_bound(value);
+        if (i < size() && !sorted.comp(value, sorted.keys[i])) {
+            return {begin() + i, false};
+        }
+        sorted.keys.insert(sorted.keys.begin() + i, value);
+        sorted.reindex();
+        return {begin() + i, true};
+    }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    template <typename InputIterator>
+    void FlatSet<Key, Compare, Allocator, Search>::insert(InputIterator first, InputIterator last)
+    {
+        Vector<Key, Allocator> incoming{sorted.keys.get_allocator()};
+        for (; first != last; ++first) {
+            incoming.push_back(*first);
+        }
+        if (incoming.empty()) {
+            return;
+        }
+        const Compare &comp = sorted.comp;
+        stable_sort(incoming, comp);
+
+        Vector<Key, Allocator> &keys = sorted.keys;
+        //all new keys sort after the present ones, e.g. building from sorted input: just append
+        if (keys.empty() || comp(keys.back(), incoming.front())) {
+            keys.reserve(keys.size() + incoming.size());
+            for (size_type j = 0; j < incoming.size(); ++j) {
+                if (keys.empty() || comp(keys.back(), incoming[j])) {
+                    keys.push_back(std::move(incoming[j]));
+                }
+            }
+            sorted.reindex();
+            return;
+        }
+
+        Vector<Key, Allocator> merged{keys.get_allocator()};
+        merged.reserve(keys.size() + incoming.size());
+        size_type i = 0, j = 0;
+        while (j < incoming.size()) {
+            if (i < keys.size() && comp(keys[i], incoming[j])) {
+                merged.push_back(std::move_if_noexcept(keys[i++]));
+            }
+            else if ((i < keys.size() && !comp(incoming[j], keys[i]))
+                     || (!merged.empty() && !comp(merged.back(), incoming[j]))) {
+                ++j; //already present, or a repeat within the range
+            }
+            else {
+                merged.push_back(std::move(incoming[j++]));
+            }
+        }
+        for (; i < keys.size(); ++i) {
+            merged.push_back(std::move_if_noexcept(keys[i]));
+        }
+        keys.swap(merged);
+        sorted.reindex();
+    }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatSet<Key, Compare, Allocator, Search>::insert(std::initializer_list<value_type> ilist)
+    { insert(ilist.begin(), ilist.end()); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::iterator FlatSet<Key, Compare, Allocator, Search>::erase(const_iterator pos)
+    {
+        size_type i = static_cast<size_type>(pos - begin());
+        sorted.keys.erase(sorted.keys.begin() + i);
+        sorted.reindex();
+        return begin() + i;
+    }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::size_type FlatSet<Key, Compare, Allocator, Search>::erase(const key_type &key)
+    {
+        size_type i = sorted.find(key);
+        if (i == size()) {
+            return 0;
+        }
+        erase(begin() + i);
+        return 1;
+    }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatSet<Key, Compare, Allocator, Search>::clear() noexcept
+    {
+        sorted.keys.clear();
+        sorted.reindex();
+    }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    void FlatSet<Key, Compare, Allocator, Search>::swap(FlatSet &other)
+    { std::swap(sorted, other.sorted); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    Span<const typename FlatSet<Key, Compare, Allocator, Search>::key_type> FlatSet<Key, Compare, Allocator, Search>::keys() const noexcept
+    { return Span<const key_type>{sorted.keys.data(), sorted.keys.size()}; }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::key_compare FlatSet<Key, Compare, Allocator, Search>::key_comp() const
+    { return sorted.comp; }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    typename FlatSet<Key, Compare, Allocator, Search>::allocator_type FlatSet<Key, Compare, Allocator, Search>::get_allocator() const
+    { return sorted.keys.get_allocator(); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    bool operator == (const FlatSet<Key, Compare, Allocator, Search> &lhs, const FlatSet<Key, Compare, Allocator, Search> &rhs)
+    { return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+
+    template <typename Key, typename Compare, typename Allocator, FlatSearch Search>
+    bool operator != (const FlatSet<Key, Compare, Allocator, Search> &lhs, const FlatSet<Key, Compare, Allocator, Search> &rhs)
+    { return !(lhs == rhs); }
+
+} //namespace sp
+
+#endif //SP_FLAT_SET__H
@@ -0,0 +1,791 @@
+//Created by sphc on 2026/10/19
+//HashMap.h
+//
+
+#ifndef SP_HASH_MAP__H
+#define SP_HASH_MAP__H
+
+#include <cstddef> //size_t, ptrdiff_t
+#include <cstdint> //int8_t, uint32_t, uint64_t
+#include <functional> //hash, equal_to
+#include <initializer_list> //initializer_list
+#include <iterator> //forward_iterator_tag, iterator_traits, distance
+#include <memory> //allocator, allocator_traits
+#include <stdexcept> //out_of_range
+#include <tuple> //forward_as_tuple
+#include <type_traits> //conditional, enable_if, is_base_of, is_trivially_destructible
+#include <utility> //pair, move, move_if_noexcept, forward, piecewise_construct, swap
+#if defined(__SSE2__)
+#include <emmintrin.h> //_mm_loadu_si128, _mm_cmpeq_epi8, _mm_cmpgt_epi8, _mm_movemask_epi8
+#endif
+#include "Vector.h"
+
+namespace sp {
+
+    namespace detail {
+
+        //one control byte per slot: empty and deleted are negative, a full slot holds the low 7
+        //bits of its hash, so a probe compares 16 candidates with one SSE2 instruction and only
+        //looks at a key when those bits agree
+        constexpr std::int8_t ctrlEmpty = -128;
+        constexpr std::int8_t ctrlDeleted = -2;
+        constexpr std::size_t groupWidth = 16;
+
+        //bit i set for every matching byte of a 16 byte window
+        class ProbeGroup {
+        public:
+            explicit ProbeGroup(const std::int8_t *ctrl)
+#if defined(__SSE2__)
+                : ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))}
+            { }
+
+            std::uint32_t match(std::int8_t h2) const
+            { return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))); }
+
+            std::uint32_t match_empty() const
+            { return match(ctrlEmpty); }
+
+            std::uint32_t match_free() const
+            { return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl))); }
+
+        private:
+            __m128i ctrl;
+#else
+                : ctrl{ctrl}
+            { }
+
+            std::uint32_t match(std::int8_t h2) const
+            {
+                std::uint32_t mask = 0;
+                for (std::size_t i = 0; i < groupWidth; ++i) {
+                    mask |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+                }
+                return mask;
+            }
+
+            std::uint32_t match_empty() const
+            { return match(ctrlEmpty); }
+
+            std::uint32_t match_free() const
+            {
+                std::uint32_t mask = 0;
+                for (std::size_t i = 0; i < groupWidth; ++i) {
+                    mask |= static_cast<std::uint32_t>(ctrl[i] < -1) << i;
+                }
+                return mask;
+            }
+
+        private:
+            const std::int8_t *ctrl;
+#endif
+        };
+
+        //std::hash is the identity for integers; fold a 128 bit product so every input bit
+        //reaches both the position and the 7 tag bits
+        inline std::uint64_t mix_hash(std::uint64_t h) noexcept
+        {
+            unsigned __int128 p = static_cast<unsigned __int128>(h) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<std::uint64_t>(p) ^ static_cast<std::uint64_t>(p >> 64);
+        }
+
+        template <typename Hash, typename KeyEqual>
+        struct IsTransparent {
+            template <typename H, typename E>
+            static std::true_type test(typename H::is_transparent *, typename E::is_transparent *);
+            template <typename H, typename E>
+            static std::false_type test(...);
+
+            static constexpr bool value = decltype(test<Hash, KeyEqual>(nullptr, nullptr))::value;
+        };
+
+    } //namespace detail
+
+    //open addressing hash map in the SwissTable layout: an array of control bytes and an array of
+    //slots, both Vector buffers, probed 16 slots at a time. Capacity is a power of two, at most
+    //7/8 of it is used. Inserting may move entries, so pointers and iterators into the map are
+    //invalidated by every insert that grows it; erase never moves other entries.
+    //With Hash::is_transparent and KeyEqual::is_transparent, find, contains, count and at accept
+    //any type the two can handle, e.g. std::string_view for std::string keys.
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+              typename Allocator = std::allocator<std::pair<const Key, T>>>
+    class HashMap {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<const Key, T> value_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+        typedef Allocator allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+
+        template <bool Const>
+        class Iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef HashMap::value_type value_type;
+            typedef HashMap::difference_type difference_type;
+            typedef typename std::conditional<Const, const value_type &, value_type &>::type reference;
+            typedef typename std::conditional<Const, const value_type *, value_type *>::type pointer;
+
+            Iterator()
+                : ctrl{nullptr}, ctrlEnd{nullptr}, slot{nullptr}
+            { }
+
+            //iterator converts to const_iterator
+            template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+            Iterator(const Iterator<OtherConst> &other)
+                : ctrl{other.ctrl}, ctrlEnd{other.ctrlEnd}, slot{other.slot}
+            { }
+
+            reference operator * () const
+            { return *slot; }
+
+            pointer operator -> () const
+            { return slot; }
+
+            Iterator &operator ++ ()
+            {
+                ++ctrl;
+                ++slot;
+                skip_free();
+                return *this;
+            }
+
+            Iterator operator ++ (int)
+            {
+                Iterator old = *this;
+                ++*this;
+                return old;
+            }
+
+            bool operator == (const Iterator &other) const
+            { return ctrl == other.ctrl; }
+
+            bool operator != (const Iterator &other) const
+            { return ctrl != other.ctrl; }
+
+        private:
+            friend class HashMap;
+            template <bool> friend class Iterator;
+
+            const std::int8_t *ctrl;
+            const std::int8_t *ctrlEnd;
+            pointer slot;
+
+            Iterator(const std::int8_t *ctrl, const std::int8_t *ctrlEnd, pointer slot)
+                : ctrl{ctrl}, ctrlEnd{ctrlEnd}, slot{slot}
+            { }
+
+            void skip_free()
+            {
+                while (ctrl != ctrlEnd && *ctrl < 0) {
+                    ++ctrl;
+                    ++slot;
+                }
+            }
+        };
+
+        typedef Iterator<false> iterator;
+        typedef Iterator<true> const_iterator;
+
+        //constructor
+        explicit HashMap(size_type count = 0, const hasher &hash = hasher{}, const key_equal &equal = key_equal{},
+                         const allocator_type &allocator = allocator_type{});
+        explicit HashMap(const allocator_type &allocator);
+        template <typename InputIterator>
+        HashMap(InputIterator first, InputIterator last, size_type count = 0, const hasher &hash = hasher{},
+                const key_equal &equal = key_equal{}, const allocator_type &allocator = allocator_type{});
+        HashMap(std::initializer_list<value_type> ilist, size_type count = 0, const hasher &hash = hasher{},
+                const key_equal &equal = key_equal{}, const allocator_type &allocator = allocator_type{});
+        HashMap(const HashMap &other);
+        HashMap(HashMap &&other);
+        ~HashMap();
+
+        //assign
+        HashMap &operator = (const HashMap &other);
+        HashMap &operator = (HashMap &&other);
+
+        //iterator
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+        //capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+        size_type capacity() const noexcept; //slots, not all usable
+        float load_factor() const noexcept;
+        //room for count entries without rehashing
+        void reserve(size_type count);
+        //rebuilds with at least count slots, dropping deleted markers
+        void rehash(size_type count);
+
+        //lookup
+        iterator find(const key_type &key);
+        const_iterator find(const key_type &key) const;
+        bool contains(const key_type &key) const;
+        size_type count(const key_type &key) const;
+        mapped_type &at(const key_type &key);
+        const mapped_type &at(const key_type &key) const;
+        mapped_type &operator [] (const key_type &key);
+
+        //heterogeneous lookup, only with a transparent hasher and key_equal
+        template <typename K, typename = typename std::enable_if<detail::IsTransparent<Hash, KeyEqual>::value, K>::type>
+        iterator find(const K &key)
+        { return iterator_at(find_index(key)); }
+
+        template <typename K, typename = typename std::enable_if<detail::IsTransparent<Hash, KeyEqual>::value, K>::type>
+        const_iterator find(const K &key) const
+        { return iterator_at(find_index(key)); }
+
+        template <typename K, typename = typename std::enable_if<detail::IsTransparent<Hash, KeyEqual>::value, K>::type>
+        bool contains(const K &key) const
+        { return find_index(key) != capacity(); }
+
+        template <typename K, typename = typename std::enable_if<detail::IsTransparent<Hash, KeyEqual>::value, K>::type>
+        size_type count(const K &key) const
+        { return contains(key) ? 1 : 0; }
+
+        template <typename K, typename = typename std::enable_if<detail::IsTransparent<Hash, KeyEqual>::value, K>::type>
+        mapped_type &at(const K &key)
+        { return checked_at(find_index(key)); }
+
+        template <typename K, typename = typename std::enable_if<detail::IsTransparent<Hash, KeyEqual>::value, K>::type>
+        const mapped_type &at(const K &key) const
+        { return checked_at(find_index(key)); }
+
+        //update
+        std::pair<iterator, bool> insert(const value_type &value);
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+        std::pair<iterator, bool> insert_or_assign(const key_type &key, const mapped_type &value);
+        //reserves for the whole range when it can be measured, then hashes entries 16 at a time
+        //and prefetches their control bytes before probing, so the cache misses overlap
+        template <typename InputIterator>
+        void insert(InputIterator first, InputIterator last);
+        void insert(std::initializer_list<value_type> ilist);
+        iterator erase(const_iterator pos);
+        size_type erase(const key_type &key);
+        void clear() noexcept;
+        void swap(HashMap &other);
+
+        //observer
+        hasher hash_function() const;
+        key_equal key_eq() const;
+        allocator_type get_allocator() const;
+
+    private:
+        struct alignas(value_type) Slot {
+            unsigned char bytes[sizeof(value_type)];
+        };
+
+        typedef std::allocator_traits<allocator_type> traits;
+        typedef typename traits::template rebind_alloc<std::int8_t> ctrl_allocator_type;
+        typedef typename traits::template rebind_alloc<Slot> slot_allocator_type;
+
+        //capacity() + groupWidth bytes; the last groupWidth mirror the first, so a window starting
+        //at any slot can be loaded without wrapping
+        Vector<std::int8_t, ctrl_allocator_type> ctrl;
+        Vector<Slot, slot_allocator_type> slots;
+        size_type theSize;
+        size_type growthLeft; //empty slots that may still be filled before a rehash
+        hasher hash;
+        key_equal equal;
+        allocator_type allocator;
+
+        value_type *slot_at(size_type index) const noexcept
+        { return reinterpret_cast<value_type *>(const_cast<Slot *>(slots.data()) + index); }
+
+        iterator iterator_at(size_type index) noexcept;
+        const_iterator iterator_at(size_type index) const noexcept;
+        mapped_type &checked_at(size_type index) const;
+
+        template <typename K>
+        std::uint64_t hash_of(const K &key) const
+        { return detail::mix_hash(static_cast<std::uint64_t>(hash(key))); }
+
+        //index of key, or capacity() if absent
+        template <typename K>
+        size_type find_index(const K &key) const;
+        template <typename K>
+        size_type find_index(const K &key, std::uint64_t h) const;
+        //first free slot on the probe sequence of h; the table must have one
+        size_type find_free(std::uint64_t h) const noexcept;
+        //slot of key; if absent, a free slot with its control byte already claimed
+        std::pair<size_type, bool> find_or_prepare(const key_type &key, std::uint64_t h);
+        void set_ctrl(size_type index, std::int8_t value) noexcept;
+        void destroy_all() noexcept;
+        static size_type capacity_for(size_type count) noexcept;
+    };
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::HashMap(size_type count, const hasher &hash, const key_equal &equal,
+                                                        const allocator_type &allocator)
+        : ctrl{ctrl_allocator_type{allocator}}, slots{slot_allocator_type{allocator}}, theSize{0}, growthLeft{0},
+          hash{hash}, equal{equal}, allocator{allocator}
+    { reserve(count); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::HashMap(const allocator_type &allocator)
+        : HashMap(0, hasher{}, key_equal{}, allocator)
+    { }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename InputIterator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::HashMap(InputIterator first, InputIterator last, size_type count,
+                                                        const hasher &hash, const key_equal &equal,
+                                                        const allocator_type &allocator)
+        : HashMap(count, hash, equal, allocator)
+    { insert(first, last); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::HashMap(std::initializer_list<value_type> ilist, size_type count,
+                                                        const hasher &hash, const key_equal &equal,
+                                                        const allocator_type &allocator)
+        : HashMap(count, hash, equal, allocator)
+    { insert(ilist.begin(), ilist.end()); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::HashMap(const HashMap &other)
+        : HashMap(other.size(), other.hash, other.equal,
+                  traits::select_on_container_copy_construction(other.allocator))
+    {
+        for (const value_type &value : other) {
+            insert(value);
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::HashMap(HashMap &&other)
+        : ctrl{std::move(other.ctrl)}, slots{std::move(other.slots)}, theSize{other.theSize},
+          growthLeft{other.growthLeft}, hash{other.hash}, equal{other.equal}, allocator{other.allocator}
+    {
+        other.theSize = 0;
+        other.growthLeft = 0;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::~HashMap()
+    { destroy_all(); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator> &HashMap<Key, T, Hash, KeyEqual, Allocator>::operator = (const HashMap &other)
+    {
+        if (this != &other) {
+            HashMap copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    HashMap<Key, T, Hash, KeyEqual, Allocator> &HashMap<Key, T, Hash, KeyEqual, Allocator>::operator = (HashMap &&other)
+    {
+        if (this != &other) {
+            HashMap moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::begin() noexcept
+    {
+        iterator it = iterator_at(0);
+        it.skip_free();
+        return it;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::end() noexcept
+    { return iterator_at(capacity()); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::const_iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::begin() const noexcept
+    {
+        const_iterator it = iterator_at(0);
+        it.skip_free();
+        return it;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::const_iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::end() const noexcept
+    { return iterator_at(capacity()); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::const_iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::cbegin() const noexcept
+    { return begin(); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::const_iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::cend() const noexcept
+    { return end(); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    bool HashMap<Key, T, Hash, KeyEqual, Allocator>::empty() const noexcept
+    { return theSize == 0; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type HashMap<Key, T, Hash, KeyEqual, Allocator>::size() const noexcept
+    { return theSize; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type HashMap<Key, T, Hash, KeyEqual, Allocator>::capacity() const noexcept
+    { return slots.size(); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    float HashMap<Key, T, Hash, KeyEqual, Allocator>::load_factor() const noexcept
+    { return capacity() ? static_cast<float>(theSize) / static_cast<float>(capacity()) : 0.0f; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::reserve(size_type count)
+    {
+        if (count > theSize + growthLeft) {
+            rehash(capacity_for(count));
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::rehash(size_type count)
+    {
+        size_type newCapacity = capacity_for(theSize);
+        while (newCapacity < count) {
+            newCapacity *= 2;
+        }
+
+        HashMap fresh(0, hash, equal, allocator);
+        fresh.ctrl = Vector<std::int8_t, ctrl_allocator_type>(newCapacity + detail::groupWidth, detail::ctrlEmpty,
+                                                               ctrl.get_allocator());
+        fresh.slots = Vector<Slot, slot_allocator_type>(newCapacity, Slot{}, slots.get_allocator());
+        fresh.growthLeft = newCapacity - newCapacity / 8;
+
+        //copy unless moving cannot throw, so a throwing copy leaves this map as it was
+        for (size_type i = 0, old = capacity(); i < old; ++i) {
+            if (ctrl[i] >= 0) {
+                value_type *from = slot_at(i);
+                std::uint64_t h = hash_of(from->first);
+                size_type to = fresh.find_free(h);
+                traits::construct(allocator, fresh.slot_at(to), std::move_if_noexcept(*from));
+                fresh.set_ctrl(to, static_cast<std::int8_t>(h & 0x7f));
+                ++fresh.theSize;
+                --fresh.growthLeft;
+            }
+        }
+        swap(fresh);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::find(const key_type &key)
+    { return iterator_at(find_index(key)); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::const_iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::find(const key_type &key) const
+    { return iterator_at(find_index(key)); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    bool HashMap<Key, T, Hash, KeyEqual, Allocator>::contains(const key_type &key) const
+    { return find_index(key) != capacity(); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type HashMap<Key, T, Hash, KeyEqual, Allocator>::count(const key_type &key) const
+    { return contains(key) ? 1 : 0; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::mapped_type &HashMap<Key, T, Hash, KeyEqual, Allocator>::at(const key_type &key)
+    { return checked_at(find_index(key)); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    const typename HashMap<Key, T, Hash, KeyEqual, Allocator>::mapped_type &HashMap<Key, T, Hash, KeyEqual, Allocator>::at(const key_type &key) const
+    { return checked_at(find_index(key)); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::mapped_type &HashMap<Key, T, Hash, KeyEqual, Allocator>::operator [] (const key_type &key)
+    { return try_emplace(key).first->second; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    std::pair<typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::insert(const value_type &value)
+    { return try_emplace(value.first, value.second); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename... Args>
+    std::pair<typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::try_emplace(const key_type &key, Args &&...args)
+    {
+        std::uint64_t h = hash_of(key);
+        std::pair<size_type, bool> found = find_or_prepare(key, h);
+        if (!found.second) {
+            try {
+                traits::construct(allocator, slot_at(found.first), std::piecewise_construct,
+                                  std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+            catch (...) {
+                //give the claimed slot back; a deleted marker keeps later probes correct
+                set_ctrl(found.first, detail::ctrlDeleted);
+                throw;
+            }
+            ++theSize;
+        }
+        return {iterator_at(found.first), !found.second};
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    std::pair<typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::insert_or_assign(const key_type &key, const mapped_type &value)
+    {
+        std::pair<iterator, bool> result = try_emplace(key, value);
+        if (!result.second) {
+            result.first->second = value;
+        }
+        return result;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename InputIterator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::insert(InputIterator first, InputIterator last)
+    {
+        typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+        if constexpr (!std::is_base_of<std::forward_iterator_tag, category>::value) {
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        }
+        else {
+            //an upper bound: repeats of present keys make the table roomier than needed
+            reserve(theSize + static_cast<size_type>(std::distance(first, last)));
+            std::uint64_t hashes[detail::groupWidth];
+            while (first != last) {
+                //first pass over the batch: hash and prefetch; second pass: probe and insert
+                InputIterator batchEnd = first;
+                size_type n = 0;
+                for (; batchEnd != last && n < detail::groupWidth; ++batchEnd, ++n) {
+                    hashes[n] = hash_of((*batchEnd).first);
+                    __builtin_prefetch(ctrl.data() + ((hashes[n] >> 7) & (capacity() - 1)));
+                }
+                for (size_type i = 0; i < n; ++i, ++first) {
+                    const value_type &value = *first;
+                    std::pair<size_type, bool> found = find_or_prepare(value.first, hashes[i]);
+                    if (!found.second) {
+                        try {
+                            traits::construct(allocator, slot_at(found.first), value);
+                        }
+                        catch (...) {
+                            set_ctrl(found.first, detail::ctrlDeleted);
+                            throw;
+                        }
+                        ++theSize;
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::insert(std::initializer_list<value_type> ilist)
+    { insert(ilist.begin(), ilist.end()); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::erase(const_iterator pos)
+    {
+        size_type index = static_cast<size_type>(pos.ctrl - ctrl.data());
+        traits::destroy(allocator, slot_at(index));
+        --theSize;
+
+        //if some window holding this slot still has an empty slot, no probe ever passed a full
+        //slot here, so the slot may become empty again instead of a deleted marker
+        size_type mask = capacity() - 1;
+        std::uint32_t emptyAfter = detail::ProbeGroup{ctrl.data() + index}.match_empty();
+        std::uint32_t emptyBefore = detail::ProbeGroup{ctrl.data() + ((index - detail::groupWidth) & mask)}.match_empty();
+        bool neverFull = emptyBefore && emptyAfter
+                         && static_cast<size_type>(__builtin_ctz(emptyAfter) + __builtin_clz(emptyBefore) - 16) < detail::groupWidth;
+        set_ctrl(index, neverFull ? detail::ctrlEmpty : detail::ctrlDeleted);
+        growthLeft += neverFull;
+
+        iterator next = iterator_at(index);
+        next.skip_free();
+        return next;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type HashMap<Key, T, Hash, KeyEqual, Allocator>::erase(const key_type &key)
+    {
+        size_type index = find_index(key);
+        if (index == capacity()) {
+            return 0;
+        }
+        erase(iterator_at(index));
+        return 1;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::clear() noexcept
+    {
+        destroy_all();
+        for (std::int8_t &c : ctrl) {
+            c = detail::ctrlEmpty;
+        }
+        theSize = 0;
+        growthLeft = capacity() - capacity() / 8;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::swap(HashMap &other)
+    {
+        ctrl.swap(other.ctrl);
+        slots.swap(other.slots);
+        std::swap(theSize, other.theSize);
+        std::swap(growthLeft, other.growthLeft);
+        std::swap(hash, other.hash);
+        std::swap(equal, other.equal);
+        std::swap(allocator, other.allocator);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::hasher HashMap<Key, T, Hash, KeyEqual, Allocator>::hash_function() const
+    { return hash; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::key_equal HashMap<Key, T, Hash, KeyEqual, Allocator>::key_eq() const
+    { return equal; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::allocator_type HashMap<Key, T, Hash, KeyEqual, Allocator>::get_allocator() const
+    { return allocator; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator_at(size_type index) noexcept
+    { return iterator{ctrl.data() + index, ctrl.data() + capacity(), slot_at(index)}; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::const_iterator HashMap<Key, T, Hash, KeyEqual, Allocator>::iterator_at(size_type index) const noexcept
+    { return const_iterator{ctrl.data() + index, ctrl.data() + capacity(), slot_at(index)}; }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::mapped_type &HashMap<Key, T, Hash, KeyEqual, Allocator>::checked_at(size_type index) const
+    {
+        if (index == capacity()) {
+            throw std::out_of_range{"sp::HashMap::at"};
+        }
+        return slot_at(index)->second;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename K>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type HashMap<Key, T, Hash, KeyEqual, Allocator>::find_index(const K &key) const
+    { return theSize ? find_index(key, hash_of(key)) : capacity(); }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename K>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::find_index(const K &key, std::uint64_t h) const
+    {
+        //triangular steps of whole windows visit every window once when capacity is a power of two
+        size_type mask = capacity() - 1, pos = (h >> 7) & mask;
+        std::int8_t h2 = static_cast<std::int8_t>(h & 0x7f);
+        for (size_type step = detail::groupWidth; ; step += detail::groupWidth) {
+            detail::ProbeGroup group{ctrl.data() + pos};
+            for (std::uint32_t m = group.match(h2); m; m &= m - 1) {
+                size_type index = (pos + static_cast<size_type>(__builtin_ctz(m))) & mask;
+                if (equal(slot_at(index)->first, key)) {
+                    return index;
+                }
+            }
+            if (group.match_empty()) {
+                return capacity();
+            }
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type HashMap<Key, T, Hash, KeyEqual, Allocator>::find_free(std::uint64_t h) const noexcept
+    {
+        size_type mask = capacity() - 1, pos = (h >> 7) & mask;
+        for (size_type step = detail::groupWidth; ; step += detail::groupWidth) {
+            std::uint32_t m = detail::ProbeGroup{ctrl.data() + pos}.match_free();
+            if (m) {
+                return (pos + static_cast<size_type>(__builtin_ctz(m))) & mask;
+            }
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    std::pair<typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type, bool>
+    HashMap<Key, T, Hash, KeyEqual, Allocator>::find_or_prepare(const key_type &key, std::uint64_t h)
+    {
+        if (theSize) {
+            size_type index = find_index(key, h);
+            if (index != capacity()) {
+                return {index, true};
+            }
+        }
+        size_type index = capacity() ? find_free(h) : 0;
+        if (capacity() == 0 || (growthLeft == 0 && ctrl[index] == detail::ctrlEmpty)) {
+            //mostly deleted markers: rebuild at the same size, otherwise double
+            rehash(theSize * 2 < capacity() - capacity() / 8 ? capacity() : capacity() * 2);
+            index = find_free(h);
+        }
+        growthLeft -= ctrl[index] == detail::ctrlEmpty;
+        set_ctrl(index, static_cast<std::int8_t>(h & 0x7f));
+        return {index, false};
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::set_ctrl(size_type index, std::int8_t value) noexcept
+    {
+        ctrl[index] = value;
+        if (index < detail::groupWidth) {
+            ctrl[capacity() + index] = value;
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void HashMap<Key, T, Hash, KeyEqual, Allocator>::destroy_all() noexcept
+    {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (size_type i = 0, n = capacity(); i < n; ++i) {
+                if (ctrl[i] >= 0) {
+                    traits::destroy(allocator, slot_at(i));
+                }
+            }
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename HashMap<Key, T, Hash, KeyEqual, Allocator>::size_type HashMap<Key, T, Hash, KeyEqual, Allocator>::capacity_for(size_type count) noexcept
+    {
+        size_type c = detail::groupWidth;
+        while (c - c / 8 < count) {
+            c *= 2;
+        }
+        return c;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    bool operator == (const HashMap<Key, T, Hash, KeyEqual, Allocator> &lhs, const HashMap<Key, T, Hash, KeyEqual, Allocator> &rhs)
+    {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const auto &entry : lhs) {
+            auto it = rhs.find(entry.first);
+            if (it == rhs.end() || !(it->second == entry.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    bool operator != (const HashMap<Key, T, Hash, KeyEqual, Allocator> &lhs, const HashMap<Key, T, Hash, KeyEqual, Allocator> &rhs)
+    { return !(lhs == rhs); }
+
+} //namespace sp
+
+#endif //SP_HASH_MAP__H
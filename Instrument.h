@@ -0,0 +1,466 @@
+//Created by sphc on 2026/10/19
+//Instrument.h
+//
+
+#ifndef SP_INSTRUMENT__H
+#define SP_INSTRUMENT__H
+
+//compile with SP_INSTRUMENTATION=1 to count what Vector and List do; every translation unit of a
+//program must agree on the setting. When it is 0 (the default) every probe below is an empty
+//inline function or an empty object and compiles away.
+#ifndef SP_INSTRUMENTATION
+#define SP_INSTRUMENTATION 0
+#endif
+
+#include <atomic> //atomic
+#include <chrono> //steady_clock, milliseconds
+#include <condition_variable> //condition_variable
+#include <cstddef> //size_t
+#include <cstdint> //uint64_t
+#include <cstdlib> //free
+#include <functional> //function
+#include <map> //map
+#include <memory> //unique_ptr
+#include <mutex> //mutex, lock_guard, unique_lock
+#include <ostream> //ostream
+#include <string> //string
+#include <thread> //thread
+#include <typeinfo> //typeid
+#include <utility> //move, pair
+#include <vector> //vector
+#include <cxxabi.h> //__cxa_demangle
+
+namespace sp {
+namespace instrument {
+
+    constexpr bool enabled = SP_INSTRUMENTATION != 0;
+
+    enum class Op { pushBack, insert };
+
+    //latency histogram with power of two buckets: bucket i holds samples in [2^i, 2^(i+1)) ns
+    struct Histogram {
+        static constexpr std::size_t buckets = 40;
+
+        std::uint64_t counts[buckets];
+        std::uint64_t totalNanos;
+
+        std::uint64_t count() const noexcept
+        {
+            std::uint64_t n = 0;
+            for (std::size_t i = 0; i < buckets; ++i) {
+                n += counts[i];
+            }
+            return n;
+        }
+
+        double mean() const noexcept
+        {
+            std::uint64_t n = count();
+            return n ? static_cast<double>(totalNanos) / static_cast<double>(n) : 0;
+        }
+
+        //upper bound in ns of the bucket holding quantile q (0 < q <= 1)
+        std::uint64_t percentile(double q) const noexcept
+        {
+            std::uint64_t n = count(), seen = 0;
+            for (std::size_t i = 0; i < buckets; ++i) {
+                seen += counts[i];
+                if (n && static_cast<double>(seen) >= q * static_cast<double>(n)) {
+                    return std::uint64_t{2} << i;
+                }
+            }
+            return 0;
+        }
+
+        Histogram &operator += (const Histogram &other) noexcept
+        {
+            for (std::size_t i = 0; i < buckets; ++i) {
+                counts[i] += other.counts[i];
+            }
+            totalNanos += other.totalNanos;
+            return *this;
+        }
+    };
+
+    //snapshot of one container type, or of all of them for global()
+    struct Stats {
+        std::uint64_t allocations;
+        std::uint64_t deallocations;
+        std::uint64_t bytesAllocated;
+        std::uint64_t bytesFreed;
+        std::uint64_t reallocations; //regrowth of an existing buffer, including shrink_to_fit
+        std::uint64_t copies; //elements copy constructed or copy assigned, relocation included
+        std::uint64_t moves; //elements move constructed or move assigned
+        std::uint64_t peakCapacity; //elements; for List the longest list seen
+        Histogram pushBack;
+        Histogram insert;
+
+        Stats &operator += (const Stats &other) noexcept
+        {
+            allocations += other.allocations;
+            deallocations += other.deallocations;
+            bytesAllocated += other.bytesAllocated;
+            bytesFreed += other.bytesFreed;
+            reallocations += other.reallocations;
+            copies += other.copies;
+            moves += other.moves;
+            peakCapacity = peakCapacity < other.peakCapacity ? other.peakCapacity : peakCapacity;
+            pushBack += other.pushBack;
+            insert += other.insert;
+            return *this;
+        }
+    };
+
+    namespace detail {
+
+        inline void add(std::atomic<std::uint64_t> &counter, std::uint64_t n) noexcept
+        { counter.fetch_add(n, std::memory_order_relaxed); }
+
+        struct AtomicHistogram {
+            std::atomic<std::uint64_t> counts[Histogram::buckets];
+            std::atomic<std::uint64_t> totalNanos;
+
+            void record(std::uint64_t nanos) noexcept
+            {
+                std::size_t i = 0;
+                while (i + 1 < Histogram::buckets && (nanos >> (i + 1))) {
+                    ++i;
+                }
+                add(counts[i], 1);
+                add(totalNanos, nanos);
+            }
+
+            Histogram load() const noexcept
+            {
+                Histogram h;
+                for (std::size_t i = 0; i < Histogram::buckets; ++i) {
+                    h.counts[i] = counts[i].load(std::memory_order_relaxed);
+                }
+                h.totalNanos = totalNanos.load(std::memory_order_relaxed);
+                return h;
+            }
+
+            void reset() noexcept
+            {
+                for (std::size_t i = 0; i < Histogram::buckets; ++i) {
+                    counts[i].store(0, std::memory_order_relaxed);
+                }
+                totalNanos.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        struct Counters {
+            std::string name;
+            std::atomic<std::uint64_t> allocations{0};
+            std::atomic<std::uint64_t> deallocations{0};
+            std::atomic<std::uint64_t> bytesAllocated{0};
+            std::atomic<std::uint64_t> bytesFreed{0};
+            std::atomic<std::uint64_t> reallocations{0};
+            std::atomic<std::uint64_t> copies{0};
+            std::atomic<std::uint64_t> moves{0};
+            std::atomic<std::uint64_t> peakCapacity{0};
+            AtomicHistogram pushBack{};
+            AtomicHistogram insert{};
+
+            explicit Counters(std::string theName)
+                : name{std::move(theName)}
+            { }
+
+            void capacity(std::uint64_t n) noexcept
+            {
+                std::uint64_t peak = peakCapacity.load(std::memory_order_relaxed);
+                while (peak < n && !peakCapacity.compare_exchange_weak(peak, n, std::memory_order_relaxed)) {
+                }
+            }
+
+            Stats load() const noexcept
+            {
+                return Stats{allocations.load(std::memory_order_relaxed), deallocations.load(std::memory_order_relaxed),
+                             bytesAllocated.load(std::memory_order_relaxed), bytesFreed.load(std::memory_order_relaxed),
+                             reallocations.load(std::memory_order_relaxed), copies.load(std::memory_order_relaxed),
+                             moves.load(std::memory_order_relaxed), peakCapacity.load(std::memory_order_relaxed),
+                             pushBack.load(), insert.load()};
+            }
+
+            void reset() noexcept
+            {
+                for (std::atomic<std::uint64_t> *c : {&allocations, &deallocations, &bytesAllocated, &bytesFreed,
+                                                      &reallocations, &copies, &moves, &peakCapacity}) {
+                    c->store(0, std::memory_order_relaxed);
+                }
+                pushBack.reset();
+                insert.reset();
+            }
+        };
+
+        //every container type that has been touched, plus regrowth per call site. Never destroyed,
+        //so containers with static storage duration can still report while the program exits.
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<Counters>> types;
+            std::map<std::string, std::uint64_t> sites;
+
+            static Registry &get()
+            {
+                static Registry *registry = new Registry;
+                return *registry;
+            }
+
+            Counters &add(std::string name)
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                types.emplace_back(new Counters{std::move(name)});
+                return *types.back();
+            }
+        };
+
+        inline std::string demangle(const char *name)
+        {
+            int status = 0;
+            char *readable = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+            std::string result = status == 0 && readable ? readable : name;
+            std::free(readable);
+            return result;
+        }
+
+        template <typename Container>
+        Counters &counters()
+        {
+            static Counters &c = Registry::get().add(demangle(typeid(Container).name()));
+            return c;
+        }
+
+        inline const char *&current_site() noexcept
+        {
+            thread_local const char *site = nullptr;
+            return site;
+        }
+
+        //nesting depth of timed operations on this thread, so the push_back inside insert is not
+        //counted twice
+        inline int &timer_depth() noexcept
+        {
+            thread_local int depth = 0;
+            return depth;
+        }
+
+        //the hooks Vector and List call; each one is empty unless instrumentation is enabled
+        template <typename Container>
+        struct Probe {
+            static void allocate(std::size_t bytes) noexcept
+            {
+                if constexpr (enabled) {
+                    Counters &c = counters<Container>();
+                    add(c.allocations, 1);
+                    add(c.bytesAllocated, bytes);
+                }
+            }
+
+            static void deallocate(std::size_t bytes) noexcept
+            {
+                if constexpr (enabled) {
+                    Counters &c = counters<Container>();
+                    add(c.deallocations, 1);
+                    add(c.bytesFreed, bytes);
+                }
+            }
+
+            static void reallocate() noexcept
+            {
+                if constexpr (enabled) {
+                    add(counters<Container>().reallocations, 1);
+                    const char *site = current_site();
+                    Registry &registry = Registry::get();
+                    std::lock_guard<std::mutex> lock{registry.mutex};
+                    ++registry.sites[site ? site : "<no site>"];
+                }
+            }
+
+            static void copy(std::size_t count) noexcept
+            {
+                if constexpr (enabled) {
+                    add(counters<Container>().copies, count);
+                }
+            }
+
+            static void move(std::size_t count) noexcept
+            {
+                if constexpr (enabled) {
+                    add(counters<Container>().moves, count);
+                }
+            }
+
+            static void capacity(std::size_t count) noexcept
+            {
+                if constexpr (enabled) {
+                    counters<Container>().capacity(count);
+                }
+            }
+        };
+
+        //times the enclosing push_back or insert into the histogram of Container
+        template <typename Container, bool = enabled>
+        class Timer {
+        public:
+            explicit Timer(Op theOp) noexcept
+                : op{theOp}, outermost{timer_depth()++ == 0}, begin{std::chrono::steady_clock::now()}
+            { }
+
+            Timer(const Timer &) = delete;
+            Timer &operator = (const Timer &) = delete;
+
+            ~Timer()
+            {
+                --timer_depth();
+                if (!outermost) {
+                    return;
+                }
+                std::uint64_t nanos = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - begin).count());
+                Counters &c = counters<Container>();
+                (op == Op::pushBack ? c.pushBack : c.insert).record(nanos);
+            }
+
+        private:
+            Op op;
+            bool outermost;
+            std::chrono::steady_clock::time_point begin;
+        };
+
+        template <typename Container>
+        class Timer<Container, false> {
+        public:
+            explicit Timer(Op) noexcept
+            { }
+        };
+
+    } //namespace detail
+
+    //labels the regrowth done on this thread while it is alive, e.g. Site site{__func__};
+    //regrowth_by_site() then shows which call sites keep reallocating
+    class Site {
+    public:
+        explicit Site(const char *name) noexcept
+            : previous{detail::current_site()}
+        { detail::current_site() = name; }
+
+        Site(const Site &) = delete;
+        Site &operator = (const Site &) = delete;
+
+        ~Site()
+        { detail::current_site() = previous; }
+
+    private:
+        const char *previous;
+    };
+
+    //stats of one container type, e.g. stats<sp::Vector<int>>()
+    template <typename Container>
+    Stats stats()
+    {
+        if constexpr (enabled) {
+            return detail::counters<Container>().load();
+        }
+        return Stats{};
+    }
+
+    //every instrumented type with its demangled name, in first use order
+    inline std::vector<std::pair<std::string, Stats>> all_stats()
+    {
+        std::vector<std::pair<std::string, Stats>> result;
+        detail::Registry &registry = detail::Registry::get();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        for (const std::unique_ptr<detail::Counters> &c : registry.types) {
+            result.emplace_back(c->name, c->load());
+        }
+        return result;
+    }
+
+    //sum over all types; peakCapacity is the largest of them
+    inline Stats global()
+    {
+        Stats total{};
+        for (const std::pair<std::string, Stats> &entry : all_stats()) {
+            total += entry.second;
+        }
+        return total;
+    }
+
+    inline std::map<std::string, std::uint64_t> regrowth_by_site()
+    {
+        detail::Registry &registry = detail::Registry::get();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        return registry.sites;
+    }
+
+    inline void reset()
+    {
+        detail::Registry &registry = detail::Registry::get();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        for (const std::unique_ptr<detail::Counters> &c : registry.types) {
+            c->reset();
+        }
+        registry.sites.clear();
+    }
+
+    inline void dump(std::ostream &out)
+    {
+        auto line = [&out](const std::string &name, const Stats &s) {
+            out << name << ": allocations " << s.allocations << " (" << s.bytesAllocated << " bytes), frees "
+                << s.deallocations << " (" << s.bytesFreed << " bytes), reallocations " << s.reallocations
+                << ", copies " << s.copies << ", moves " << s.moves << ", peak capacity " << s.peakCapacity
+                << ", push_back p50/p99 " << s.pushBack.percentile(0.5) << "/" << s.pushBack.percentile(0.99)
+                << " ns, insert p50/p99 " << s.insert.percentile(0.5) << "/" << s.insert.percentile(0.99) << " ns\n";
+        };
+        for (const std::pair<std::string, Stats> &entry : all_stats()) {
+            line(entry.first, entry.second);
+        }
+        line("global", global());
+        for (const std::pair<const std::string, std::uint64_t> &site : regrowth_by_site()) {
+            out << "regrowth at " << site.first << ": " << site.second << "\n";
+        }
+        out.flush();
+    }
+
+    //calls hook every interval on a background thread until destroyed
+    class PeriodicDump {
+    public:
+        PeriodicDump(std::chrono::milliseconds interval, std::function<void()> hook)
+            : stopping{false}, worker{[this, interval, hook] {
+                  std::unique_lock<std::mutex> lock{mutex};
+                  while (!wakeup.wait_for(lock, interval, [this] { return stopping; })) {
+                      lock.unlock();
+                      hook();
+                      lock.lock();
+                  }
+              }}
+        { }
+
+        PeriodicDump(std::chrono::milliseconds interval, std::ostream &out)
+            : PeriodicDump(interval, [&out] { dump(out); })
+        { }
+
+        PeriodicDump(const PeriodicDump &) = delete;
+        PeriodicDump &operator = (const PeriodicDump &) = delete;
+
+        ~PeriodicDump()
+        {
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                stopping = true;
+            }
+            wakeup.notify_one();
+            worker.join();
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable wakeup;
+        bool stopping;
+        std::thread worker;
+    };
+
+} //namespace instrument
+} //namespace sp
+
+#endif //SP_INSTRUMENT__H
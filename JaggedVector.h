@@ -0,0 +1,499 @@
+//Created by sphc on 2026/10/19
+//JaggedVector.h
+//
+
+#ifndef SP_JAGGED_VECTOR__H
+#define SP_JAGGED_VECTOR__H
+
+#include <algorithm> //copy, equal
+#include <cstddef> //size_t, ptrdiff_t
+#include <initializer_list> //initializer_list
+#include <iterator> //distance, advance, random_access_iterator_tag
+#include <memory> //allocator
+#include <utility> //move
+#include <stdexcept> //out_of_range
+#include <type_traits> //conditional
+#include "Vector.h"
+#include "Span.h"
+
+namespace sp {
+
+    //rows of varying length in compressed sparse row layout: every element of every row lives in
+    //one contiguous buffer, row i is elements [offsets[i], offsets[i + 1]). One allocation for all
+    //rows instead of one per row, and a row costs one offset instead of a Vector header.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class JaggedVector {
+    public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Span<T> row_type;
+        typedef Span<const T> const_row_type;
+
+        template <bool Const>
+        class RowIterator {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef typename std::conditional<Const, Span<const T>, Span<T>>::type value_type;
+            typedef JaggedVector::difference_type difference_type;
+            typedef value_type reference;
+            typedef void pointer;
+
+            RowIterator(typename std::conditional<Const, const JaggedVector *, JaggedVector *>::type owner, size_type row)
+                : owner{owner}, row{row}
+            { }
+
+            reference operator * () const
+            { return (*owner)[row]; }
+
+            reference operator [] (difference_type step) const
+            { return (*owner)[row + step]; }
+
+            RowIterator &operator ++ ()
+            {
+                ++row;
+                return *this;
+            }
+
+            RowIterator operator ++ (int)
+            {
+                RowIterator old = *this;
+                ++row;
+                return old;
+            }
+
+            RowIterator &operator -- ()
+            {
+                --row;
+                return *this;
+            }
+
+            RowIterator operator -- (int)
+            {
+                RowIterator old = *this;
+                --row;
+                return old;
+            }
+
+            RowIterator operator + (difference_type step) const
+            { return RowIterator{owner, row + step}; }
+
+            RowIterator operator - (difference_type step) const
+            { return RowIterator{owner, row - step}; }
+
+            difference_type operator - (const RowIterator &other) const
+            { return static_cast<difference_type>(row) - static_cast<difference_type>(other.row); }
+
+            bool operator == (const RowIterator &other) const
+            { return row == other.row; }
+
+            bool operator != (const RowIterator &other) const
+            { return row != other.row; }
+
+            bool operator < (const RowIterator &other) const
+            { return row < other.row; }
+
+        private:
+            typename std::conditional<Const, const JaggedVector *, JaggedVector *>::type owner;
+            size_type row;
+        };
+
+        typedef RowIterator<false> iterator;
+        typedef RowIterator<true> const_iterator;
+
+        //collects (row, value) pairs in any order, e.g. the edges of a graph, and lays them out
+        //with a counting sort; values of a row keep the order they were added in
+        class Builder {
+        public:
+            explicit Builder(size_type rows = 0);
+
+            void reserve(size_type values);
+            void add(size_type row, const value_type &value);
+            JaggedVector build() const;
+
+        private:
+            Vector<size_type> rowOf;
+            Vector<value_type, allocator_type> values;
+            size_type rowCount;
+        };
+
+        //constructor
+        explicit JaggedVector(const allocator_type &allocator = allocator_type{});
+        JaggedVector(std::initializer_list<std::initializer_list<value_type>> rows,
+                     const allocator_type &allocator = allocator_type{});
+        JaggedVector(const JaggedVector &other) = default;
+        JaggedVector(JaggedVector &&other);
+
+        //assign
+        JaggedVector &operator = (const JaggedVector &other) = default;
+        JaggedVector &operator = (JaggedVector &&other);
+
+        //access row
+        row_type operator [] (size_type row);
+        const_row_type operator [] (size_type row) const;
+        row_type at(size_type row);
+        const_row_type at(size_type row) const;
+        row_type front();
+        const_row_type front() const;
+        row_type back();
+        const_row_type back() const;
+        size_type row_size(size_type row) const;
+
+        //flat access: all elements row after row, and the size() + 1 row boundaries
+        Span<value_type> elements();
+        Span<const value_type> elements() const;
+        Span<const size_type> offsets() const;
+
+        //iterator over rows
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+
+        //capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept; //rows
+        size_type element_count() const noexcept;
+        void reserve(size_type rows, size_type elements);
+        void shrink_to_fit();
+
+        //update
+        void clear() noexcept;
+        template <typename InputIterator>
+        row_type push_back(InputIterator first, InputIterator last);
+        row_type push_back(std::initializer_list<value_type> row);
+        row_type push_back(size_type count, const value_type &value);
+        row_type push_back_empty();
+        void extend_back(const value_type &value); //appends to the last row
+        void pop_back();
+        //rewrites a row; same length writes in place, otherwise only the elements after it move
+        template <typename InputIterator>
+        void assign_row(size_type row, InputIterator first, InputIterator last);
+        void assign_row(size_type row, std::initializer_list<value_type> values);
+        void swap(JaggedVector &other);
+
+    private:
+        Vector<value_type, allocator_type> data;
+        Vector<size_type> bounds; //size() + 1 entries, bounds[0] == 0
+    };
+
+    template <typename T, typename Allocator>
+    JaggedVector<T, Allocator>::Builder::Builder(size_type rows)
+        : rowCount{rows}
+    { }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::Builder::reserve(size_type count)
+    {
+        rowOf.reserve(count);
+        values.reserve(count);
+    }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::Builder::add(size_type row, const value_type &value)
+    {
+        rowOf.push_back(row);
+        values.push_back(value);
+        rowCount = row + 1 > rowCount ? row + 1 : rowCount;
+    }
+
+    template <typename T, typename Allocator>
+    JaggedVector<T, Allocator> JaggedVector<T, Allocator>::Builder::build() const
+    {
+        JaggedVector result{values.get_allocator()};
+        result.bounds.assign(rowCount + 1, 0);
+        for (size_type row : rowOf) {
+            ++result.bounds[row + 1];
+        }
+        for (size_type i = 0; i < rowCount; ++i) {
+            result.bounds[i + 1] += result.bounds[i];
+        }
+
+        Vector<size_type> next(result.bounds.begin(), result.bounds.end() - 1);
+        Vector<size_type> slot(values.size(), 0);
+        for (size_type i = 0; i < values.size(); ++i) {
+            slot[i] = next[rowOf[i]]++;
+        }
+        //place by inverting the permutation, so value_type needs no default constructor
+        Vector<size_type> source(values.size(), 0);
+        for (size_type i = 0; i < values.size(); ++i) {
+            source[slot[i]] = i;
+        }
+        result.data.reserve(values.size());
+        for (size_type i = 0; i < values.size(); ++i) {
+            result.data.push_back(values[source[i]]);
+        }
+        return result;
+    }
+
+    template <typename T, typename Allocator>
+    JaggedVector<T, Allocator>::JaggedVector(const allocator_type &allocator)
+        : data{allocator}, bounds(size_type{1}, size_type{0})
+    { }
+
+    template <typename T, typename Allocator>
+    JaggedVector<T, Allocator>::JaggedVector(std::initializer_list<std::initializer_list<value_type>> rows,
+                                             const allocator_type &allocator)
+        : JaggedVector(allocator)
+    {
+        size_type total = 0;
+        for (const std::initializer_list<value_type> &row : rows) {
+            total += row.size();
+        }
+        reserve(rows.size(), total);
+        for (const std::initializer_list<value_type> &row : rows) {
+            push_back(row);
+        }
+    }
+
+    //the moved-from JaggedVector is left empty, not without its leading offset
+    template <typename T, typename Allocator>
+    JaggedVector<T, Allocator>::JaggedVector(JaggedVector &&other)
+        : JaggedVector(other.data.get_allocator())
+    { swap(other); }
+
+    template <typename T, typename Allocator>
+    JaggedVector<T, Allocator> &JaggedVector<T, Allocator>::operator = (JaggedVector &&other)
+    {
+        if (this != &other) {
+            JaggedVector moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::operator [] (size_type row)
+    { return row_type{data.data() + bounds[row], bounds[row + 1] - bounds[row]}; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_row_type JaggedVector<T, Allocator>::operator [] (size_type row) const
+    { return const_row_type{data.data() + bounds[row], bounds[row + 1] - bounds[row]}; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::at(size_type row)
+    {
+        if (row >= size()) {
+            throw std::out_of_range{"sp::JaggedVector::at"};
+        }
+        return (*this)[row];
+    }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_row_type JaggedVector<T, Allocator>::at(size_type row) const
+    {
+        if (row >= size()) {
+            throw std::out_of_range{"sp::JaggedVector::at"};
+        }
+        return (*this)[row];
+    }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::front()
+    { return (*this)[0]; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_row_type JaggedVector<T, Allocator>::front() const
+    { return (*this)[0]; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::back()
+    { return (*this)[size() - 1]; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_row_type JaggedVector<T, Allocator>::back() const
+    { return (*this)[size() - 1]; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::size_type JaggedVector<T, Allocator>::row_size(size_type row) const
+    { return bounds[row + 1] - bounds[row]; }
+
+    template <typename T, typename Allocator>
+    Span<typename JaggedVector<T, Allocator>::value_type> JaggedVector<T, Allocator>::elements()
+    { return Span<value_type>{data.data(), data.size()}; }
+
+    template <typename T, typename Allocator>
+    Span<const typename JaggedVector<T, Allocator>::value_type> JaggedVector<T, Allocator>::elements() const
+    { return Span<const value_type>{data.data(), data.size()}; }
+
+    template <typename T, typename Allocator>
+    Span<const typename JaggedVector<T, Allocator>::size_type> JaggedVector<T, Allocator>::offsets() const
+    { return Span<const size_type>{bounds.data(), bounds.size()}; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::iterator JaggedVector<T, Allocator>::begin()
+    { return iterator{this, 0}; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::iterator JaggedVector<T, Allocator>::end()
+    { return iterator{this, size()}; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_iterator JaggedVector<T, Allocator>::begin() const
+    { return const_iterator{this, 0}; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_iterator JaggedVector<T, Allocator>::end() const
+    { return const_iterator{this, size()}; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_iterator JaggedVector<T, Allocator>::cbegin() const
+    { return begin(); }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::const_iterator JaggedVector<T, Allocator>::cend() const
+    { return end(); }
+
+    template <typename T, typename Allocator>
+    bool JaggedVector<T, Allocator>::empty() const noexcept
+    { return bounds.size() == 1; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::size_type JaggedVector<T, Allocator>::size() const noexcept
+    { return bounds.size() - 1; }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::size_type JaggedVector<T, Allocator>::element_count() const noexcept
+    { return data.size(); }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::reserve(size_type rows, size_type elements)
+    {
+        bounds.reserve(rows + 1);
+        data.reserve(elements);
+    }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::shrink_to_fit()
+    {
+        bounds.shrink_to_fit();
+        data.shrink_to_fit();
+    }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::clear() noexcept
+    {
+        data.clear();
+        bounds.resize(1);
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIterator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::push_back(InputIterator first, InputIterator last)
+    {
+        size_type oldSize = data.size();
+        try {
+            for (; first != last; ++first) {
+                data.push_back(*first);
+            }
+            bounds.push_back(data.size());
+        }
+        catch (...) {
+            data.resize(oldSize);
+            throw;
+        }
+        return back();
+    }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::push_back(std::initializer_list<value_type> row)
+    {
+        data.reserve(data.size() + row.size());
+        return push_back(row.begin(), row.end());
+    }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::push_back(size_type count, const value_type &value)
+    {
+        size_type oldSize = data.size();
+        try {
+            data.resize(oldSize + count, value);
+            bounds.push_back(data.size());
+        }
+        catch (...) {
+            data.resize(oldSize);
+            throw;
+        }
+        return back();
+    }
+
+    template <typename T, typename Allocator>
+    typename JaggedVector<T, Allocator>::row_type JaggedVector<T, Allocator>::push_back_empty()
+    {
+        bounds.push_back(data.size());
+        return back();
+    }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::extend_back(const value_type &value)
+    {
+        data.push_back(value);
+        ++bounds.back();
+    }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::pop_back()
+    {
+        bounds.pop_back();
+        data.resize(bounds.back());
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIterator>
+    void JaggedVector<T, Allocator>::assign_row(size_type row, InputIterator first, InputIterator last)
+    {
+        size_type oldLength = row_size(row);
+        size_type newLength = static_cast<size_type>(std::distance(first, last));
+        typename Vector<value_type, allocator_type>::iterator at = data.begin() + bounds[row];
+
+        if (newLength > oldLength) {
+            InputIterator mid = first;
+            std::advance(mid, oldLength);
+            data.insert(at + oldLength, mid, last);
+            at = data.begin() + bounds[row];
+            last = mid;
+        }
+        else if (newLength < oldLength) {
+            data.erase(at + newLength, at + oldLength);
+        }
+        std::copy(first, last, data.begin() + bounds[row]);
+
+        if (newLength != oldLength) {
+            for (size_type i = row + 1; i < bounds.size(); ++i) {
+                bounds[i] = bounds[i] + newLength - oldLength;
+            }
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::assign_row(size_type row, std::initializer_list<value_type> values)
+    { assign_row(row, values.begin(), values.end()); }
+
+    template <typename T, typename Allocator>
+    void JaggedVector<T, Allocator>::swap(JaggedVector &other)
+    {
+        data.swap(other.data);
+        bounds.swap(other.bounds);
+    }
+
+    template <typename T, typename Allocator>
+    bool operator == (const JaggedVector<T, Allocator> &lhs, const JaggedVector<T, Allocator> &rhs)
+    {
+        if (lhs.size() != rhs.size() || lhs.element_count() != rhs.element_count()) {
+            return false;
+        }
+        Span<const typename JaggedVector<T, Allocator>::size_type> a = lhs.offsets(), b = rhs.offsets();
+        Span<const T> x = lhs.elements(), y = rhs.elements();
+        return std::equal(a.begin(), a.end(), b.begin()) && std::equal(x.begin(), x.end(), y.begin());
+    }
+
+    template <typename T, typename Allocator>
+    bool operator != (const JaggedVector<T, Allocator> &lhs, const JaggedVector<T, Allocator> &rhs)
+    { return !(lhs == rhs); }
+
+} //namespace sp
+
+#endif //SP_JAGGED_VECTOR__H
@@ -6,10 +6,13 @@
 #define LIST__H
 
 #include <cstddef> //size_t ptrdiff_t
-#include <memory> //allocator
+#include <memory> //allocator, allocator_traits
 #include <initializer_list> //initializer_list
 #include <climits> //UINT_MAX
-#include <functional> //less
+#include <functional> //less, equal_to
+#include <iterator> //bidirectional_iterator_tag
+#include <utility> //pair, move, forward, swap
+#include "Instrument.h"
 
 namespace sp {
 
@@ -22,15 +25,26 @@ namespace sp {
         typedef std::ptrdiff_t difference_type;
         typedef value_type &reference;
         typedef const value_type &const_reference;
-        typedef std::allocator_traits<Allocator>::pointer pointer;
-        typedef std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
 
+    private:
+        struct Node;
+
+    public:
         class const_iterator {
+            friend class List;
         public:
-            const_iterator(List *theList, Node *content) 
-                : this->theList{theList}, this->content{content} { }
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef List::value_type value_type;
+            typedef List::difference_type difference_type;
+            typedef const value_type *pointer;
+            typedef const value_type &reference;
 
-            const_iterator operator ++ ()
+            const_iterator(const List *theList, Node *content) 
+                : content{content}, theList{theList} { }
+
+            const_iterator &operator ++ ()
             { 
                 content = content->next;
                 return *this; 
@@ -43,7 +57,7 @@ namespace sp {
                 return old; 
             }
 
-            const_iterator operator -- ()
+            const_iterator &operator -- ()
             {
                 content = content->prior;
                 return *this; 
@@ -59,58 +73,75 @@ namespace sp {
             const_reference operator * () const
             { return content->data; }
 
-            const_pointer operator -> () const
+            const value_type *operator -> () const
             { return &content->data; }
 
-        private:
+            bool operator == (const const_iterator &other) const
+            { return content == other.content; }
+
+            bool operator != (const const_iterator &other) const
+            { return content != other.content; }
+
+        protected:
             Node *content;
-            List *theList;
+            const List *theList;
         };
 
         class iterator : public const_iterator {
+            friend class List;
         public:
+            typedef List::reference reference;
+            typedef value_type *pointer;
+
             iterator(List *theList, Node *content) 
                 : const_iterator{theList, content} { }
 
-            iterator operator ++ ()
+            iterator &operator ++ ()
             { 
-                content = content->next;
+                this->content = this->content->next;
                 return *this; 
             }
 
             iterator operator ++ (int)
             { 
-                const_iterator old = *this;
-                content = content->next;
+                iterator old = *this;
+                this->content = this->content->next;
                 return old; 
             }
 
-            iterator operator -- ()
+            iterator &operator -- ()
             { 
-                content = content->prior;
+                this->content = this->content->prior;
                 return *this; 
             }
 
             iterator operator -- (int)
             { 
                 iterator old = *this;
-                content = content->prior;
+                this->content = this->content->prior;
                 return old; 
             }
 
             reference operator * () const
-            { return content->data; }
+            { return this->content->data; }
 
-            pointer operator -> () const
-            { return &content->data; }
+            value_type *operator -> () const
+            { return &this->content->data; }
         };
 
         class const_reverse_iterator {
+            friend class List;
         public:
-            const_reverse_iterator(List *theList, Node *content) 
-                : this->theList{theList}, this->content{content} { }
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef List::value_type value_type;
+            typedef List::difference_type difference_type;
+            typedef const value_type *pointer;
+            typedef const value_type &reference;
 
-            const_reverse_iterator operator ++ ()
+            const_reverse_iterator(const List *theList, Node *content) 
+                : content{content}, theList{theList} { }
+
+            const_reverse_iterator &operator ++ ()
             { 
                 content = content->prior;
                 return *this; 
@@ -123,7 +154,7 @@ namespace sp {
                 return old; 
             }
 
-            const_reverse_iterator operator -- ()
+            const_reverse_iterator &operator -- ()
             {
                 content = content->next;
                 return *this; 
@@ -139,54 +170,59 @@ namespace sp {
             const_reference operator * () const
             { return content->data; }
 
-            const_pointer operator -> () const
+            const value_type *operator -> () const
             { return &content->data; }
 
-        private:
+            bool operator == (const const_reverse_iterator &other) const
+            { return content == other.content; }
+
+            bool operator != (const const_reverse_iterator &other) const
+            { return content != other.content; }
+
+        protected:
             Node *content;
-            List *theList;
+            const List *theList;
         };
 
         class reverse_iterator : public const_reverse_iterator {
         public:
+            typedef List::reference reference;
+            typedef value_type *pointer;
+
             reverse_iterator(List *theList, Node *content) 
                 : const_reverse_iterator{theList, content} { }
 
-            reverse_iterator operator ++ ()
+            reverse_iterator &operator ++ ()
             { 
-                content = content->prior;
+                this->content = this->content->prior;
                 return *this; 
             }
 
             reverse_iterator operator ++ (int)
             { 
                 reverse_iterator old = *this;
-                content = content->prior;
+                this->content = this->content->prior;
                 return old; 
             }
 
-            reverse_iterator operator -- ()
+            reverse_iterator &operator -- ()
             {
-                content = content->next;
+                this->content = this->content->next;
                 return *this; 
             }
 
             reverse_iterator operator -- (int)
             { 
                 reverse_iterator old = *this;
-                content = content->next;
+                this->content = this->content->next;
                 return old; 
             }
 
             reference operator * () const
-            { return content->data; }
-
-            pointer operator -> () const
-            { return &content->data; }
+            { return this->content->data; }
 
-        private:
-            Node *content;
-            List *theList;
+            value_type *operator -> () const
+            { return &this->content->data; }
         };
 
         //constructor
@@ -290,23 +326,35 @@ namespace sp {
         void sort(Compare comp);
 
     private:
-        class Node {
+        struct Node {
             value_type data;
-            value_type *prior;
-            value_type *next;
+            Node *prior;
+            Node *next;
+
+            Node() : data{}, prior{nullptr}, next{nullptr} { }
 
-            Node(const value_type &data, value_type *prior, value_type *next) :
-                this->data{data}, this->prior{prior}, this->next{next} { }
+            Node(const value_type &data, Node *prior = nullptr, Node *next = nullptr) :
+                data{data}, prior{prior}, next{next} { }
 
-            Node(value_type &&data, value_type *prior, value_type *next) :
-                this->data{std::move(data)}, this->prior{prior}, this->next{next} { }
+            Node(value_type &&data, Node *prior = nullptr, Node *next = nullptr) :
+                data{std::move(data)}, prior{prior}, next{next} { }
         };
-        
+
+
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_allocator;
+        typedef std::allocator_traits<node_allocator> node_traits;
+
+        node_allocator allocator; //first, the sentinels are allocated from it
         Node *head;
         Node *tail;
         size_type theSize;
-        allocator_type allocator;
 
+        typedef instrument::detail::Probe<List> probe;
+        typedef instrument::detail::Timer<List> timer;
+
+        template <typename... Args>
+        Node *make_node(Args &&... args);
+        void drop_node(Node *node) noexcept;
         iterator insert_node(const_iterator pos, Node &node);
         std::pair<iterator, Node *> erase_node(const_iterator pos);
         void free();
@@ -314,15 +362,15 @@ namespace sp {
 
     //constructor
     template <typename T, typename Allocator>
-    explicit List<T, Allocator>::List(const Allocator &alloc = Allocator()) 
-        : allocator{alloc}, head{new Node}, tail{new Node}, theSize{}
+    List<T, Allocator>::List(const Allocator &alloc) 
+        : allocator{alloc}, head{make_node()}, tail{make_node()}, theSize{}
     { 
         head->next = tail;
         tail->prior = head;
     }
 
     template <typename T, typename Allocator>
-    List<T, Allocator>::List(size_type count, const value_type &value, const allocator_type &alloc = allocator_type{})
+    List<T, Allocator>::List(size_type count, const value_type &value, const allocator_type &alloc)
         : List(alloc)//allocator{alloc}
     {
         while (count--) {
@@ -331,12 +379,12 @@ namespace sp {
     }
 
     template <typename T, typename Allocator>
-    explicit List<T, Allocator>::List(size_type count) : List(count, value_type{})
+    List<T, Allocator>::List(size_type count) : List(count, value_type{})
     { }
 
     template <typename T, typename Allocator>
     template <typename InputIterator>
-    List<T, Allocator>::List(InputIterator first, InputIterator last, const allocator_type &alloc = allocator_type{}) 
+    List<T, Allocator>::List(InputIterator first, InputIterator last, const allocator_type &alloc) 
         : List(alloc)
     { insert(begin(), first, last); }
 
@@ -352,15 +400,8 @@ namespace sp {
 
     template <typename T, typename Allocator>
     List<T, Allocator>::List(List &&other) 
-        : List(other.get_allocator)
-    {
-        const_iterator first = other.cbegin();
-        const_iterator last = other.cend();
-
-        while (first != last) {
-            push_back(std::move(*first++));
-        }
-    }
+        : List(other.get_allocator())
+    { swap(other); }
 
     /*
     template <typename T, typename Allocator>
@@ -368,40 +409,40 @@ namespace sp {
     */
 
     template <typename T, typename Allocator>
-    List<T, Allocator>::List(std::initializer_list<value_type> init, const allocator_type &alloc = allocator_type{})
+    List<T, Allocator>::List(std::initializer_list<value_type> init, const allocator_type &alloc)
         : List(init.begin(), init.end(), alloc)
     { }
 
     template <typename T, typename Allocator>
-    ~List<T, Allocator>::List()
+    List<T, Allocator>::~List()
     { free(); }
 
     //assign
     template <typename T, typename Allocator>
-    List<T, Allocator>::List &List<T, Allocator>::operator = (const List &other)
+    List<T, Allocator> &List<T, Allocator>::operator = (const List &other)
     {
         if (this != &other) {
             assign(other.begin(), other.end());
         }
+        return *this;
     }
 
     template <typename T, typename Allocator>
-    List<T, Allocator>::List &List<T, Allocator>::operator = (List &&other)
+    List<T, Allocator> &List<T, Allocator>::operator = (List &&other)
     {
         if (this != &other) {
             clear();
-            const_iterator first = other.cbegin();
-            const_iterator last = other.cend();
-
-            while (first != last) {
-                push_back(std::move(*first++));
-            }
+            swap(other);
         }
+        return *this;
     }
 
     template <typename T, typename Allocator>
-    List<T, Allocator>::List &List<T, Allocator>::operator = (std::initializer_list<value_type> ilist)
-    { assign(ilist); }
+    List<T, Allocator> &List<T, Allocator>::operator = (std::initializer_list<value_type> ilist)
+    { 
+        assign(ilist); 
+        return *this;
+    }
 
     template <typename T, typename Allocator>
     void List<T, Allocator>::assign(size_type count, const value_type &value)
@@ -414,7 +455,7 @@ namespace sp {
     template <typename InputIterator>
     void List<T, Allocator>::assign(InputIterator first, InputIterator last)
     {
-        claer();
+        clear();
         insert(begin(), first, last);
     }
 
@@ -425,7 +466,7 @@ namespace sp {
     //getallocator
     template <typename T, typename Allocator>
     typename List<T, Allocator>::allocator_type List<T, Allocator>::get_allocator() const
-    { return allocator; }
+    { return allocator_type{allocator}; }
 
     //access
     template <typename T, typename Allocator>
@@ -459,7 +500,7 @@ namespace sp {
 
     template <typename T, typename Allocator>
     typename List<T, Allocator>::const_iterator List<T, Allocator>::end() const noexcept
-    { return const_iterator{this, tail};
+    { return const_iterator{this, tail}; }
 
     template <typename T, typename Allocator>
     typename List<T, Allocator>::const_iterator List<T, Allocator>::cbegin() const noexcept
@@ -520,7 +561,11 @@ namespace sp {
     {
         //Node *p = pos.content;
         //return iterator{this, p->prior = p->prior->next = new Node{value, p->prior, p}};
-        return insert_node(pos, *new Node{value});
+        timer timed{instrument::Op::insert};
+        iterator it = insert_node(pos, *make_node(value));
+        probe::copy(1);
+        probe::capacity(theSize);
+        return it;
     }
 
     template <typename T, typename Allocator>
@@ -528,7 +573,11 @@ namespace sp {
     {
         //Node *p = pos.content;
         //return iterator{this, p->prior = p->prior->next = new Node{std::move(value), p->prior, p}};
-        return insert_node(pos, *new Node{std::move(value)});
+        timer timed{instrument::Op::insert};
+        iterator it = insert_node(pos, *make_node(std::move(value)));
+        probe::move(1);
+        probe::capacity(theSize);
+        return it;
     }
 
     template <typename T, typename Allocator>
@@ -570,7 +619,7 @@ namespace sp {
         p->next->prior = p-prior;
         delete p;
         */
-        delete result.second;
+        drop_node(result.second);
 
         return result.first;
     }
@@ -590,7 +639,7 @@ namespace sp {
 
     template <typename T, typename Allocator>
     void List<T, Allocator>::push_front(value_type &&value)
-    { insert(begin(), std::move(value); }
+    { insert(begin(), std::move(value)); }
 
     /*
     template <typename... Args>
@@ -602,11 +651,17 @@ namespace sp {
 
     template <typename T, typename Allocator>
     void List<T, Allocator>::push_back(const value_type &value)
-    { insert(end(), value); }
+    {
+        timer timed{instrument::Op::pushBack};
+        insert(end(), value);
+    }
 
     template <typename T, typename Allocator>
     void List<T, Allocator>::push_back(value_type &&value)
-    { insert(end(), std::move(value); }
+    {
+        timer timed{instrument::Op::pushBack};
+        insert(end(), std::move(value));
+    }
 
     /*
     template <<typename... Args>
@@ -653,7 +708,7 @@ namespace sp {
             iterator i = this->begin(), j = other.begin();
             while (i != this->end() && j != other.end()) {
                 if (comp(*j, *i)) {
-                    std::pair<iterator, Node *> tmp = erase_node(*j);
+                    std::pair<iterator, Node *> tmp = other.erase_node(j);
                     j = tmp.first;
                     insert_node(i, *tmp.second);
                 }
@@ -662,7 +717,7 @@ namespace sp {
                 }
             }
             while (j != other.end()) {
-                std::pair<iterator, Node *> tmp = erase_node(*j);
+                std::pair<iterator, Node *> tmp = other.erase_node(j);
                 j = tmp.first;
                 insert_node(i, *tmp.second);
             }
@@ -670,69 +725,176 @@ namespace sp {
     }
 
     template <typename T, typename Allocator>
-    void List<T, Allocator>::splice(const_iterator pos, List &&other);
+    void List<T, Allocator>::splice(const_iterator pos, List &&other)
+    { splice(pos, std::move(other), other.begin(), other.end()); }
 
     template <typename T, typename Allocator>
-    void List<T, Allocator>::splice(const_iterator pos, List &&other, const_iterator it);
+    void List<T, Allocator>::splice(const_iterator pos, List &&other, const_iterator it)
+    {
+        const_iterator last = it;
+        splice(pos, std::move(other), it, ++last);
+    }
 
     template <typename T, typename Allocator>
-    void List<T, Allocator>::splice(const_iterator pos, List &&other, const_iterator first, const_iterator last);
+    void List<T, Allocator>::splice(const_iterator pos, List &&other, const_iterator first, const_iterator last)
+    {
+        if (first == last) {
+            return;
+        }
+        if (this != &other) {
+            size_type count = 0;
+            for (const_iterator it = first; it != last; ++it) {
+                ++count;
+            }
+            other.theSize -= count;
+            theSize += count;
+        }
+
+        Node *p = pos.content, *f = first.content, *l = last.content->prior;
+
+        f->prior->next = l->next;
+        l->next->prior = f->prior;
+
+        f->prior = p->prior;
+        l->next = p;
+        p->prior->next = f;
+        p->prior = l;
+    }
 
     template <typename T, typename Allocator>
-    void List<T, Allocator>::remove(const value_type &value);
+    void List<T, Allocator>::remove(const value_type &value)
+    { remove_if([&value](const value_type &x) { return x == value; }); }
 
     template <typename T, typename Allocator>
     template <typename UnaryPredicate>
-    void List<T, Allocator>::remove_if(UnaryPredicate p);
+    void List<T, Allocator>::remove_if(UnaryPredicate p)
+    {
+        iterator it = begin();
+        while (it != end()) {
+            if (p(*it)) {
+                it = erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
 
     template <typename T, typename Allocator>
-    void List<T, Allocator>::reverse() noexcept;
+    void List<T, Allocator>::reverse() noexcept
+    {
+        Node *p = head;
+        while (p) {
+            std::swap(p->prior, p->next);
+            p = p->prior;
+        }
+        std::swap(head, tail);
+    }
 
     template <typename T, typename Allocator>
-    void List<T, Allocator>::unique();
+    void List<T, Allocator>::unique()
+    { unique(std::equal_to<T>{}); }
     
     template <typename T, typename Allocator>
     template <typename BinaryPredicate>
-    void List<T, Allocator>::unique(BinaryPredicate p);
+    void List<T, Allocator>::unique(BinaryPredicate p)
+    {
+        if (empty()) {
+            return;
+        }
+        iterator prev = begin(), it = prev;
+        while (++it != end()) {
+            if (p(*prev, *it)) {
+                it = erase(it);
+                --it;
+            }
+            else {
+                prev = it;
+            }
+        }
+    }
 
     template <typename T, typename Allocator>
-    void List<T, Allocator>::sort();
+    void List<T, Allocator>::sort()
+    { sort(std::less<T>{}); }
 
+    //merge sort by splicing: split in halves, sort both, merge back
     template <typename T, typename Allocator>
     template <typename Compare>
-    void List<T, Allocator>::sort(Compare comp);
+    void List<T, Allocator>::sort(Compare comp)
+    {
+        if (theSize < 2) {
+            return;
+        }
+
+        List right(get_allocator());
+        iterator mid = begin();
+        for (size_type i = 0; i < theSize / 2; ++i) {
+            ++mid;
+        }
+        right.splice(right.begin(), std::move(*this), mid, end());
+
+        sort(comp);
+        right.sort(comp);
+        merge(std::move(right), comp);
+    }
+
+    //nodes, sentinels included, come from Allocator rebound to Node
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    typename List<T, Allocator>::Node *List<T, Allocator>::make_node(Args &&... args)
+    {
+        Node *node = node_traits::allocate(allocator, 1);
+        try {
+            node_traits::construct(allocator, node, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            node_traits::deallocate(allocator, node, 1);
+            throw;
+        }
+        probe::allocate(sizeof(Node));
+        return node;
+    }
+
+    template <typename T, typename Allocator>
+    void List<T, Allocator>::drop_node(Node *node) noexcept
+    {
+        node_traits::destroy(allocator, node);
+        node_traits::deallocate(allocator, node, 1);
+        probe::deallocate(sizeof(Node));
+    }
 
     template <typename T, typename Allocator>
     typename List<T, Allocator>::iterator List<T, Allocator>::insert_node(const_iterator pos, Node &node)
     {
         Node *p = pos.content;
 
-        node->prior = p->prior;
-        node->next = p;
+        node.prior = p->prior;
+        node.next = p;
         ++theSize;
 
         return iterator{this, p->prior = p->prior->next = &node};
     }
 
     template <typename T, typename Allocator>
-    std::pair<typename List<T, Allocator>::iterator, typename List<T, Allocator>::Node> List<T, Allocator>::erase_node(const_iterator pos)
+    std::pair<typename List<T, Allocator>::iterator, typename List<T, Allocator>::Node *> List<T, Allocator>::erase_node(const_iterator pos)
     {
         Node *p = pos.content;
         iterator it{this, p->next};
 
         p->prior->next = p->next;
-        p->next->prior = p-prior;
+        p->next->prior = p->prior;
         --theSize;
 
-        return std::pair{it, p};
+        return std::pair<iterator, Node *>{it, p};
     }
 
     template <typename T, typename Allocator>
     void List<T, Allocator>::free()
     {
         clear();
-        delete head;
-        delete tail;
+        drop_node(head);
+        drop_node(tail);
     }
 
 } //namespace sp
@@ -0,0 +1,526 @@
+//Created by sphc on 2026/10/19
+//MappedVector.h
+//
+
+#ifndef SP_MAPPED_VECTOR__H
+#define SP_MAPPED_VECTOR__H
+
+#include <cstddef> //size_t, ptrdiff_t
+#include <cerrno> //errno
+#include <iterator> //reverse_iterator
+#include <stdexcept> //out_of_range, runtime_error
+#include <string> //string
+#include <system_error> //system_error
+#include <type_traits> //is_trivially_copyable
+#include <fcntl.h> //open
+#include <sys/mman.h> //mmap, mremap, munmap, msync
+#include <sys/stat.h> //fstat
+#include <unistd.h> //ftruncate, close
+#include "Vector.h"
+#include "Serialize.h"
+
+namespace sp {
+
+    enum class MapMode {
+        readOnly, //existing file, PROT_READ
+        readWrite //created with an empty payload if missing
+    };
+
+    //Vector's read API over a memory-mapped file in the Serialize.h format. Opening only maps
+    //the file, pages are faulted in on first touch. Growing extends the file and remaps.
+    template <typename T>
+    class MappedVector {
+    public:
+        typedef T value_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef value_type *pointer;
+        typedef const value_type *const_pointer;
+        typedef value_type *iterator;
+        typedef const value_type *const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::size_t size_type;
+
+        //constructor
+        explicit MappedVector(const std::string &path, MapMode mode = MapMode::readWrite);
+        MappedVector(MappedVector &&other) noexcept;
+        MappedVector(const MappedVector &) = delete;
+        ~MappedVector();
+
+        //assign
+        MappedVector &operator = (MappedVector &&other) noexcept;
+        MappedVector &operator = (const MappedVector &) = delete;
+
+        //access element
+        reference at(size_type index);
+        const_reference at(size_type index) const;
+        reference operator [] (size_type index);
+        const_reference operator [] (size_type index) const;
+        reference front();
+        const_reference front() const;
+        reference back();
+        const_reference back() const;
+        value_type *data() noexcept;
+        const value_type *data() const noexcept;
+
+        //iterator
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+        reverse_iterator rbegin() noexcept;
+        reverse_iterator rend() noexcept;
+        const_reverse_iterator rbegin() const noexcept;
+        const_reverse_iterator rend() const noexcept;
+        const_reverse_iterator crbegin() const noexcept;
+        const_reverse_iterator crend() const noexcept;
+
+        //capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+        size_type capacity() const noexcept;
+        void reserve(size_type newCapacity);
+        void shrink_to_fit();
+
+        //update
+        void clear();
+        void push_back(const value_type &value);
+        void pop_back();
+        void resize(size_type count, const value_type &value = value_type{});
+
+        //writes dirty pages back to the file
+        void flush();
+
+    private:
+        int fd;
+        bool writable;
+        char *base; //start of the mapping, the header lives here
+        std::size_t mapped; //bytes mapped
+        SerialHeader *header;
+        value_type *start;
+        size_type theCapacity;
+
+        static std::size_t file_bytes(size_type count) noexcept
+        { return sizeof(SerialHeader) + count * sizeof(value_type); }
+
+        void remap(size_type newCapacity);
+        void prepare_write();
+        void release() noexcept;
+    };
+
+    template <typename T>
+    MappedVector<T>::MappedVector(const std::string &path, MapMode mode)
+        : fd{-1}, writable{mode == MapMode::readWrite}, base{nullptr}, mapped{0}, header{nullptr}, start{nullptr}, theCapacity{0}
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "MappedVector requires a trivially copyable type");
+        static_assert(alignof(T) <= sizeof(SerialHeader), "MappedVector payload would be misaligned");
+
+        fd = writable ? ::open(path.c_str(), O_RDWR | O_CREAT, 0644) : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error{errno, std::generic_category(), "sp::MappedVector: open"};
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error{err, std::generic_category(), "sp::MappedVector: fstat"};
+        }
+        std::size_t bytes = static_cast<std::size_t>(st.st_size);
+
+        if (bytes == 0 && writable) {
+            SerialHeader fresh = detail::make_header<T>(0, Checksum{}.value());
+            if (::ftruncate(fd, sizeof(fresh)) < 0 || ::pwrite(fd, &fresh, sizeof(fresh), 0) != static_cast<ssize_t>(sizeof(fresh))) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error{err, std::generic_category(), "sp::MappedVector: init"};
+            }
+            bytes = sizeof(fresh);
+        }
+        if (bytes < sizeof(SerialHeader)) {
+            ::close(fd);
+            throw std::runtime_error{"sp::MappedVector: file too small"};
+        }
+
+        void *p = ::mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error{err, std::generic_category(), "sp::MappedVector: mmap"};
+        }
+        base = static_cast<char *>(p);
+        mapped = bytes;
+        header = reinterpret_cast<SerialHeader *>(base);
+        start = reinterpret_cast<value_type *>(base + sizeof(SerialHeader));
+        theCapacity = (bytes - sizeof(SerialHeader)) / sizeof(value_type);
+
+        const char *error = nullptr;
+        if (header->magic != serialMagic) {
+            error = "sp::MappedVector: bad magic or byte order";
+        }
+        else if (header->version != serialVersion) {
+            error = "sp::MappedVector: unsupported version";
+        }
+        else if (header->elementSize != sizeof(value_type)) {
+            error = "sp::MappedVector: element size mismatch";
+        }
+        else if (header->count > theCapacity) {
+            error = "sp::MappedVector: truncated payload";
+        }
+        if (error) {
+            writable = false; //not our file format, leave its size alone
+            release();
+            throw std::runtime_error{error};
+        }
+    }
+
+    template <typename T>
+    MappedVector<T>::MappedVector(MappedVector &&other) noexcept
+        : fd{other.fd}, writable{other.writable}, base{other.base}, mapped{other.mapped},
+          header{other.header}, start{other.start}, theCapacity{other.theCapacity}
+    {
+        other.fd = -1;
+        other.base = nullptr;
+        other.header = nullptr;
+        other.start = nullptr;
+        other.mapped = other.theCapacity = 0;
+    }
+
+    template <typename T>
+    MappedVector<T>::~MappedVector()
+    { release(); }
+
+    template <typename T>
+    MappedVector<T> &MappedVector<T>::operator = (MappedVector &&other) noexcept
+    {
+        if (this != &other) {
+            release();
+            fd = other.fd;
+            writable = other.writable;
+            base = other.base;
+            mapped = other.mapped;
+            header = other.header;
+            start = other.start;
+            theCapacity = other.theCapacity;
+            other.fd = -1;
+            other.base = nullptr;
+            other.header = nullptr;
+            other.start = nullptr;
+            other.mapped = other.theCapacity = 0;
+        }
+        return *this;
+    }
+
+    template <typename T>
+    typename MappedVector<T>::reference MappedVector<T>::at(size_type index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range{"sp::MappedVector::at"};
+        }
+        return start[index];
+    }
+
+    template <typename T>
+    typename MappedVector<T>::const_reference MappedVector<T>::at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range{"sp::MappedVector::at"};
+        }
+        return start[index];
+    }
+
+    template <typename T>
+    typename MappedVector<T>::reference MappedVector<T>::operator [] (size_type index)
+    { return start[index]; }
+
+    template <typename T>
+    typename MappedVector<T>::const_reference MappedVector<T>::operator [] (size_type index) const
+    { return start[index]; }
+
+    template <typename T>
+    typename MappedVector<T>::reference MappedVector<T>::front()
+    { return start[0]; }
+
+    template <typename T>
+    typename MappedVector<T>::const_reference MappedVector<T>::front() const
+    { return start[0]; }
+
+    template <typename T>
+    typename MappedVector<T>::reference MappedVector<T>::back()
+    { return start[size() - 1]; }
+
+    template <typename T>
+    typename MappedVector<T>::const_reference MappedVector<T>::back() const
+    { return start[size() - 1]; }
+
+    template <typename T>
+    typename MappedVector<T>::value_type *MappedVector<T>::data() noexcept
+    { return start; }
+
+    template <typename T>
+    const typename MappedVector<T>::value_type *MappedVector<T>::data() const noexcept
+    { return start; }
+
+    template <typename T>
+    typename MappedVector<T>::iterator MappedVector<T>::begin() noexcept
+    { return start; }
+
+    template <typename T>
+    typename MappedVector<T>::iterator MappedVector<T>::end() noexcept
+    { return start + size(); }
+
+    template <typename T>
+    typename MappedVector<T>::const_iterator MappedVector<T>::begin() const noexcept
+    { return start; }
+
+    template <typename T>
+    typename MappedVector<T>::const_iterator MappedVector<T>::end() const noexcept
+    { return start + size(); }
+
+    template <typename T>
+    typename MappedVector<T>::const_iterator MappedVector<T>::cbegin() const noexcept
+    { return start; }
+
+    template <typename T>
+    typename MappedVector<T>::const_iterator MappedVector<T>::cend() const noexcept
+    { return start + size(); }
+
+    template <typename T>
+    typename MappedVector<T>::reverse_iterator MappedVector<T>::rbegin() noexcept
+    { return reverse_iterator{end()}; }
+
+    template <typename T>
+    typename MappedVector<T>::reverse_iterator MappedVector<T>::rend() noexcept
+    { return reverse_iterator{begin()}; }
+
+    template <typename T>
+    typename MappedVector<T>::const_reverse_iterator MappedVector<T>::rbegin() const noexcept
+    { return const_reverse_iterator{end()}; }
+
+    template <typename T>
+    typename MappedVector<T>::const_reverse_iterator MappedVector<T>::rend() const noexcept
+    { return const_reverse_iterator{begin()}; }
+
+    template <typename T>
+    typename MappedVector<T>::const_reverse_iterator MappedVector<T>::crbegin() const noexcept
+    { return const_reverse_iterator{end()}; }
+
+    template <typename T>
+    typename MappedVector<T>::const_reverse_iterator MappedVector<T>::crend() const noexcept
+    { return const_reverse_iterator{begin()}; }
+
+    template <typename T>
+    bool MappedVector<T>::empty() const noexcept
+    { return size() == 0; }
+
+    template <typename T>
+    typename MappedVector<T>::size_type MappedVector<T>::size() const noexcept
+    { return static_cast<size_type>(header->count); }
+
+    template <typename T>
+    typename MappedVector<T>::size_type MappedVector<T>::capacity() const noexcept
+    { return theCapacity; }
+
+    template <typename T>
+    void MappedVector<T>::reserve(size_type newCapacity)
+    {
+        if (newCapacity > capacity()) {
+            remap(newCapacity);
+        }
+    }
+
+    template <typename T>
+    void MappedVector<T>::shrink_to_fit()
+    {
+        if (capacity() > size()) {
+            remap(size());
+        }
+    }
+
+    template <typename T>
+    void MappedVector<T>::clear()
+    { resize(0); }
+
+    template <typename T>
+    void MappedVector<T>::push_back(const value_type &value)
+    {
+        prepare_write();
+        if (size() == capacity()) {
+            remap(capacity() ? 2 * capacity() : 16);
+        }
+        start[header->count++] = value;
+    }
+
+    template <typename T>
+    void MappedVector<T>::pop_back()
+    {
+        prepare_write();
+        --header->count;
+    }
+
+    template <typename T>
+    void MappedVector<T>::resize(size_type count, const value_type &value)
+    {
+        prepare_write();
+        if (count > capacity()) {
+            remap(count);
+        }
+        for (size_type i = size(); i < count; ++i) {
+            start[i] = value;
+        }
+        header->count = count;
+    }
+
+    template <typename T>
+    void MappedVector<T>::flush()
+    {
+        if (writable && ::msync(base, mapped, MS_SYNC) < 0) {
+            throw std::system_error{errno, std::generic_category(), "sp::MappedVector: msync"};
+        }
+    }
+
+    //the file grows first so the new pages are backed, then the mapping follows it
+    template <typename T>
+    void MappedVector<T>::remap(size_type newCapacity)
+    {
+        prepare_write();
+
+        std::size_t bytes = file_bytes(newCapacity);
+        if (bytes > mapped && ::ftruncate(fd, static_cast<off_t>(bytes)) < 0) {
+            throw std::system_error{errno, std::generic_category(), "sp::MappedVector: ftruncate"};
+        }
+        void *p = ::mremap(base, mapped, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            throw std::system_error{errno, std::generic_category(), "sp::MappedVector: mremap"};
+        }
+        if (bytes < mapped && ::ftruncate(fd, static_cast<off_t>(bytes)) < 0) {
+            throw std::system_error{errno, std::generic_category(), "sp::MappedVector: ftruncate"};
+        }
+
+        base = static_cast<char *>(p);
+        mapped = bytes;
+        header = reinterpret_cast<SerialHeader *>(base);
+        start = reinterpret_cast<value_type *>(base + sizeof(SerialHeader));
+        theCapacity = newCapacity;
+    }
+
+    //in-place writes leave the header checksum stale
+    template <typename T>
+    void MappedVector<T>::prepare_write()
+    {
+        if (!writable) {
+            throw std::runtime_error{"sp::MappedVector: mapped read-only"};
+        }
+        header->flags |= serialFlagNoChecksum;
+    }
+
+    //drops the spare capacity from the file so it stays a plain serialized Vector
+    template <typename T>
+    void MappedVector<T>::release() noexcept
+    {
+        if (base) {
+            std::size_t bytes = file_bytes(size());
+            ::munmap(base, mapped);
+            if (writable && bytes < mapped) {
+                int ignored = ::ftruncate(fd, static_cast<off_t>(bytes));
+                (void)ignored;
+            }
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        fd = -1;
+        base = nullptr;
+        header = nullptr;
+        start = nullptr;
+        mapped = theCapacity = 0;
+    }
+
+    namespace detail {
+
+        template <typename Lhs, typename Rhs>
+        bool range_equal(const Lhs &lhs, const Rhs &rhs)
+        {
+            if (lhs.size() != rhs.size()) {
+                return false;
+            }
+            auto j = rhs.begin();
+            for (auto i = lhs.begin(); i != lhs.end(); ++i, ++j) {
+                if (!(*i == *j)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename Lhs, typename Rhs>
+        bool range_less(const Lhs &lhs, const Rhs &rhs)
+        {
+            auto i = lhs.begin();
+            auto j = rhs.begin();
+
+            while (i != lhs.end() && j != rhs.end() && *i == *j) {
+                ++i;
+                ++j;
+            }
+
+            return i != lhs.end() && j != rhs.end() ? *i < *j : j != rhs.end();
+        }
+
+    } //namespace detail
+
+    template <typename T>
+    bool operator == (const MappedVector<T> &lhs, const MappedVector<T> &rhs)
+    { return detail::range_equal(lhs, rhs); }
+
+    template <typename T>
+    bool operator != (const MappedVector<T> &lhs, const MappedVector<T> &rhs)
+    { return !(lhs == rhs); }
+
+    template <typename T>
+    bool operator < (const MappedVector<T> &lhs, const MappedVector<T> &rhs)
+    { return detail::range_less(lhs, rhs); }
+
+    template <typename T>
+    bool operator <= (const MappedVector<T> &lhs, const MappedVector<T> &rhs)
+    { return !(rhs < lhs); }
+
+    template <typename T>
+    bool operator > (const MappedVector<T> &lhs, const MappedVector<T> &rhs)
+    { return rhs < lhs; }
+
+    template <typename T>
+    bool operator >= (const MappedVector<T> &lhs, const MappedVector<T> &rhs)
+    { return !(lhs < rhs); }
+
+    template <typename T, typename Allocator>
+    bool operator == (const MappedVector<T> &lhs, const Vector<T, Allocator> &rhs)
+    { return detail::range_equal(lhs, rhs); }
+
+    template <typename T, typename Allocator>
+    bool operator == (const Vector<T, Allocator> &lhs, const MappedVector<T> &rhs)
+    { return detail::range_equal(lhs, rhs); }
+
+    template <typename T, typename Allocator>
+    bool operator != (const MappedVector<T> &lhs, const Vector<T, Allocator> &rhs)
+    { return !(lhs == rhs); }
+
+    template <typename T, typename Allocator>
+    bool operator != (const Vector<T, Allocator> &lhs, const MappedVector<T> &rhs)
+    { return !(lhs == rhs); }
+
+    template <typename T, typename Allocator>
+    bool operator < (const MappedVector<T> &lhs, const Vector<T, Allocator> &rhs)
+    { return detail::range_less(lhs, rhs); }
+
+    template <typename T, typename Allocator>
+    bool operator < (const Vector<T, Allocator> &lhs, const MappedVector<T> &rhs)
+    { return detail::range_less(lhs, rhs); }
+
+} //namespace sp
+
+#endif //SP_MAPPED_VECTOR__H
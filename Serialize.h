@@ -0,0 +1,303 @@
+//Created by sphc on 2026/10/19
+//Serialize.h
+//
+
+#ifndef SP_SERIALIZE__H
+#define SP_SERIALIZE__H
+
+#include <cstddef> //size_t
+#include <cstdint> //uint16_t, uint32_t, uint64_t
+#include <cstring> //memcpy
+#include <istream> //istream
+#include <ostream> //ostream
+#include <stdexcept> //runtime_error
+#include <type_traits> //is_trivially_copyable
+#include "Vector.h"
+#include "List.h"
+
+namespace sp {
+
+    //on-disk layout, version 1:
+    //  SerialHeader (32 bytes, native byte order) followed by count * elementSize payload bytes
+    struct SerialHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t flags; //serialFlag* bits
+        std::uint32_t elementSize;
+        std::uint32_t reserved;
+        std::uint64_t count;
+        std::uint64_t checksum; //Checksum of the payload
+    };
+
+    constexpr std::uint32_t serialMagic = 0x52535053; //"SPSR" when read as little endian
+    constexpr std::uint16_t serialVersion = 1;
+    constexpr std::uint16_t serialFlagNoChecksum = 1; //payload was modified in place, checksum is stale
+
+    //streaming 64-bit payload checksum over four independent lanes, so it keeps up with memcpy
+    class Checksum {
+    public:
+        Checksum() noexcept
+            : lane{seed + prime1 + prime2, seed + prime2, seed, seed - prime1}, pendingBytes{0}, total{0}
+        { }
+
+        void update(const void *data, std::size_t bytes) noexcept
+        {
+            if (bytes == 0) {
+                return;
+            }
+            const unsigned char *p = static_cast<const unsigned char *>(data);
+            total += bytes;
+
+            if (pendingBytes) {
+                std::size_t take = stripe - pendingBytes < bytes ? stripe - pendingBytes : bytes;
+                std::memcpy(pending + pendingBytes, p, take);
+                pendingBytes += take;
+                p += take;
+                bytes -= take;
+                if (pendingBytes < stripe) {
+                    return;
+                }
+                consume(pending);
+                pendingBytes = 0;
+            }
+            while (bytes >= stripe) {
+                consume(p);
+                p += stripe;
+                bytes -= stripe;
+            }
+            std::memcpy(pending, p, bytes);
+            pendingBytes = bytes;
+        }
+
+        std::uint64_t value() const noexcept
+        {
+            std::uint64_t h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18);
+            for (int i = 0; i < 4; ++i) {
+                h = (h ^ round(0, lane[i])) * prime1 + prime4;
+            }
+            h += total;
+
+            std::size_t i = 0;
+            for (; i + 8 <= pendingBytes; i += 8) {
+                h = rotl(h ^ round(0, load(pending + i)), 27) * prime1 + prime4;
+            }
+            for (; i < pendingBytes; ++i) {
+                h = rotl(h ^ (pending[i] * prime5), 11) * prime1;
+            }
+
+            h ^= h >> 33;
+            h *= prime2;
+            h ^= h >> 29;
+            h *= prime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+    private:
+        static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+        static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+        static constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+        static constexpr std::uint64_t seed = 0;
+        static constexpr std::size_t stripe = 32;
+
+        std::uint64_t lane[4];
+        unsigned char pending[stripe];
+        std::size_t pendingBytes;
+        std::uint64_t total;
+
+        static std::uint64_t rotl(std::uint64_t x, int r) noexcept
+        { return (x << r) | (x >> (64 - r)); }
+
+        static std::uint64_t round(std::uint64_t acc, std::uint64_t input) noexcept
+        { return rotl(acc + input * prime2, 31) * prime1; }
+
+        static std::uint64_t load(const unsigned char *p) noexcept
+        {
+            std::uint64_t x;
+            std::memcpy(&x, p, sizeof(x));
+            return x;
+        }
+
+        void consume(const unsigned char *p) noexcept
+        {
+            lane[0] = round(lane[0], load(p));
+            lane[1] = round(lane[1], load(p + 8));
+            lane[2] = round(lane[2], load(p + 16));
+            lane[3] = round(lane[3], load(p + 24));
+        }
+    };
+
+    namespace detail {
+
+        template <typename T>
+        SerialHeader make_header(std::uint64_t count, std::uint64_t checksum)
+        {
+            SerialHeader header{};
+            header.magic = serialMagic;
+            header.version = serialVersion;
+            header.elementSize = sizeof(T);
+            header.count = count;
+            header.checksum = checksum;
+            return header;
+        }
+
+        template <typename T>
+        SerialHeader read_header(std::istream &in)
+        {
+            SerialHeader header;
+            if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+                throw std::runtime_error{"sp::deserialize: truncated header"};
+            }
+            if (header.magic != serialMagic) {
+                throw std::runtime_error{"sp::deserialize: bad magic or byte order"};
+            }
+            if (header.version != serialVersion) {
+                throw std::runtime_error{"sp::deserialize: unsupported version"};
+            }
+            if (header.elementSize != sizeof(T)) {
+                throw std::runtime_error{"sp::deserialize: element size mismatch"};
+            }
+            return header;
+        }
+
+        inline void write_bytes(std::ostream &out, const void *data, std::size_t bytes)
+        {
+            if (!out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes))) {
+                throw std::runtime_error{"sp::serialize: write failed"};
+            }
+        }
+
+        inline void read_bytes(std::istream &in, void *data, std::size_t bytes)
+        {
+            if (!in.read(static_cast<char *>(data), static_cast<std::streamsize>(bytes))) {
+                throw std::runtime_error{"sp::deserialize: truncated payload"};
+            }
+        }
+
+        inline void verify(const Checksum &sum, const SerialHeader &header)
+        {
+            if (!(header.flags & serialFlagNoChecksum) && sum.value() != header.checksum) {
+                throw std::runtime_error{"sp::deserialize: checksum mismatch"};
+            }
+        }
+
+    } //namespace detail
+
+    //header plus the whole payload in a single write from data()
+    template <typename T, typename Allocator>
+    void serialize(const Vector<T, Allocator> &v, std::ostream &out)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "sp::serialize requires a trivially copyable type");
+
+        Checksum sum;
+        sum.update(v.data(), v.size() * sizeof(T));
+        SerialHeader header = detail::make_header<T>(v.size(), sum.value());
+
+        detail::write_bytes(out, &header, sizeof(header));
+        detail::write_bytes(out, v.data(), v.size() * sizeof(T));
+    }
+
+    //replaces v's contents; the payload is read with a single read into data()
+    template <typename T, typename Allocator>
+    void deserialize(Vector<T, Allocator> &v, std::istream &in)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "sp::deserialize requires a trivially copyable type");
+
+        SerialHeader header = detail::read_header<T>(in);
+        v.clear();
+        v.read_exact(in, header.count);
+
+        Checksum sum;
+        sum.update(v.data(), v.size() * sizeof(T));
+        detail::verify(sum, header);
+    }
+
+    //elements are written straight from the nodes, no staging buffer
+    template <typename T, typename Allocator>
+    void serialize(const List<T, Allocator> &l, std::ostream &out)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "sp::serialize requires a trivially copyable type");
+
+        Checksum sum;
+        for (const T &x : l) {
+            sum.update(&x, sizeof(T));
+        }
+        SerialHeader header = detail::make_header<T>(l.size(), sum.value());
+
+        detail::write_bytes(out, &header, sizeof(header));
+        for (const T &x : l) {
+            detail::write_bytes(out, &x, sizeof(T));
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void deserialize(List<T, Allocator> &l, std::istream &in)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "sp::deserialize requires a trivially copyable type");
+
+        SerialHeader header = detail::read_header<T>(in);
+        l.clear();
+
+        Checksum sum;
+        T value;
+        for (std::uint64_t i = 0; i < header.count; ++i) {
+            detail::read_bytes(in, &value, sizeof(T));
+            sum.update(&value, sizeof(T));
+            l.push_back(value);
+        }
+        detail::verify(sum, header);
+    }
+
+    //consumes a serialized Vector or List a chunk at a time; the checksum is verified
+    //when the last chunk is read
+    template <typename T>
+    class ChunkReader {
+    public:
+        explicit ChunkReader(std::istream &in)
+            : in{in}, header{detail::read_header<T>(in)}, consumed{0}
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "sp::ChunkReader requires a trivially copyable type");
+            if (done()) {
+                detail::verify(sum, header);
+            }
+        }
+
+        std::uint64_t size() const noexcept
+        { return header.count; }
+
+        std::uint64_t remaining() const noexcept
+        { return header.count - consumed; }
+
+        bool done() const noexcept
+        { return consumed == header.count; }
+
+        //replaces chunk's contents with the next at most maxElements elements, returns how many
+        template <typename Allocator>
+        std::size_t next(Vector<T, Allocator> &chunk, std::size_t maxElements)
+        {
+            std::size_t count = remaining() < maxElements ? static_cast<std::size_t>(remaining()) : maxElements;
+            chunk.clear();
+            if (count == 0) {
+                return 0;
+            }
+            chunk.read_exact(in, count);
+            sum.update(chunk.data(), count * sizeof(T));
+            consumed += count;
+            if (done()) {
+                detail::verify(sum, header);
+            }
+            return count;
+        }
+
+    private:
+        std::istream &in;
+        SerialHeader header;
+        std::uint64_t consumed;
+        Checksum sum;
+    };
+
+} //namespace sp
+
+#endif //SP_SERIALIZE__H
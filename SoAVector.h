@@ -0,0 +1,727 @@
+//Created by sphc on 2026/10/19
+//SoAVector.h
+//
+
+#ifndef SP_SOA_VECTOR__H
+#define SP_SOA_VECTOR__H
+
+#include <algorithm> //max, move, move_backward, rotate
+#include <cstddef> //size_t, ptrdiff_t
+#include <initializer_list> //initializer_list
+#include <iterator> //random_access_iterator_tag
+#include <memory> //allocator, uninitialized_move, uninitialized_copy
+#include <new> //placement new
+#include <stdexcept> //out_of_range
+#include <tuple> //tuple, get, tuple_element, tuple_size
+#include <type_traits> //integral_constant, conditional, enable_if, is_nothrow_move_constructible
+#include <utility> //index_sequence, forward, move, swap
+#include "Span.h"
+
+namespace sp {
+
+    template <typename... Fields>
+    class SoAVector;
+
+    //proxy for one row: get<I>() is a reference into column I
+    template <typename Owner, bool Const>
+    class SoARow {
+    public:
+        typedef typename Owner::value_type value_type;
+        typedef typename Owner::size_type size_type;
+
+        template <size_type I>
+        using field_type = typename std::conditional<Const, const typename Owner::template field_type<I>,
+                                                     typename Owner::template field_type<I>>::type;
+
+        SoARow(typename std::conditional<Const, const Owner *, Owner *>::type owner, size_type index) noexcept
+            : owner{owner}, row{index}
+        { }
+
+        //a mutable row converts to a read-only one
+        template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        SoARow(const SoARow<Owner, OtherConst> &other) noexcept
+            : owner{other.owner}, row{other.row}
+        { }
+
+        SoARow(const SoARow &) = default;
+
+        template <size_type I>
+        field_type<I> &get() const noexcept
+        { return owner->template data<I>()[row]; }
+
+        size_type index() const noexcept
+        { return row; }
+
+        operator value_type() const
+        { return load(std::make_index_sequence<Owner::columns>{}); }
+
+        //assignment writes through to the columns, like vector<bool>::reference
+        SoARow &operator = (const value_type &value)
+        {
+            store(value, std::make_index_sequence<Owner::columns>{});
+            return *this;
+        }
+
+        SoARow &operator = (const SoARow &other)
+        { return *this = static_cast<value_type>(other); }
+
+        bool operator == (const value_type &value) const
+        { return static_cast<value_type>(*this) == value; }
+
+        bool operator != (const value_type &value) const
+        { return !(*this == value); }
+
+    private:
+        template <typename, bool>
+        friend class SoARow;
+
+        typename std::conditional<Const, const Owner *, Owner *>::type owner;
+        size_type row;
+
+        template <std::size_t... I>
+        value_type load(std::index_sequence<I...>) const
+        { return value_type{get<I>()...}; }
+
+        template <std::size_t... I>
+        void store(const value_type &value, std::index_sequence<I...>)
+        { ((get<I>() = std::get<I>(value)), ...); }
+    };
+
+    template <typename Owner, bool Const>
+    class SoAIterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename Owner::value_type value_type;
+        typedef typename Owner::difference_type difference_type;
+        typedef typename Owner::size_type size_type;
+        typedef SoARow<Owner, Const> reference;
+        typedef void pointer;
+
+        SoAIterator() noexcept
+            : owner{nullptr}, row{0}
+        { }
+
+        SoAIterator(typename std::conditional<Const, const Owner *, Owner *>::type owner, size_type index) noexcept
+            : owner{owner}, row{index}
+        { }
+
+        template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+        SoAIterator(const SoAIterator<Owner, OtherConst> &other) noexcept
+            : owner{other.owner}, row{other.row}
+        { }
+
+        reference operator * () const noexcept
+        { return reference{owner, row}; }
+
+        reference operator [] (difference_type step) const noexcept
+        { return reference{owner, row + step}; }
+
+        size_type index() const noexcept
+        { return row; }
+
+        SoAIterator &operator ++ () noexcept
+        {
+            ++row;
+            return *this;
+        }
+
+        SoAIterator operator ++ (int) noexcept
+        {
+            SoAIterator old = *this;
+            ++row;
+            return old;
+        }
+
+        SoAIterator &operator -- () noexcept
+        {
+            --row;
+            return *this;
+        }
+
+        SoAIterator operator -- (int) noexcept
+        {
+            SoAIterator old = *this;
+            --row;
+            return old;
+        }
+
+        SoAIterator &operator += (difference_type step) noexcept
+        {
+            row += step;
+            return *this;
+        }
+
+        SoAIterator &operator -= (difference_type step) noexcept
+        {
+            row -= step;
+            return *this;
+        }
+
+        SoAIterator operator + (difference_type step) const noexcept
+        { return SoAIterator{owner, row + step}; }
+
+        SoAIterator operator - (difference_type step) const noexcept
+        { return SoAIterator{owner, row - step}; }
+
+        difference_type operator - (const SoAIterator &other) const noexcept
+        { return static_cast<difference_type>(row) - static_cast<difference_type>(other.row); }
+
+        bool operator == (const SoAIterator &other) const noexcept
+        { return row == other.row; }
+
+        bool operator != (const SoAIterator &other) const noexcept
+        { return row != other.row; }
+
+        bool operator < (const SoAIterator &other) const noexcept
+        { return row < other.row; }
+
+        bool operator > (const SoAIterator &other) const noexcept
+        { return row > other.row; }
+
+        bool operator <= (const SoAIterator &other) const noexcept
+        { return row <= other.row; }
+
+        bool operator >= (const SoAIterator &other) const noexcept
+        { return row >= other.row; }
+
+    private:
+        template <typename, bool>
+        friend class SoAIterator;
+
+        typename std::conditional<Const, const Owner *, Owner *>::type owner;
+        size_type row;
+    };
+
+    //structure of arrays: column I holds field I of every row. All columns share one allocation,
+    //one size and one capacity, so growing relocates every column in a single reallocation.
+    //Each column starts on a 64-byte boundary.
+    template <typename... Fields>
+    class SoAVector {
+        static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    public:
+        typedef std::tuple<Fields...> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef SoARow<SoAVector, false> reference;
+        typedef SoARow<SoAVector, true> const_reference;
+        typedef SoAIterator<SoAVector, false> iterator;
+        typedef SoAIterator<SoAVector, true> const_iterator;
+
+        static constexpr size_type columns = sizeof...(Fields);
+
+        template <size_type I>
+        using field_type = typename std::tuple_element<I, value_type>::type;
+
+        //constructor
+        SoAVector() noexcept;
+        explicit SoAVector(size_type count);
+        SoAVector(size_type count, const Fields &... values);
+        SoAVector(std::initializer_list<value_type> ilist);
+        SoAVector(const SoAVector &other);
+        SoAVector(SoAVector &&other) noexcept;
+        ~SoAVector();
+
+        //assign
+        SoAVector &operator = (const SoAVector &other);
+        SoAVector &operator = (SoAVector &&other) noexcept;
+
+        //access element
+        reference operator [] (size_type index) noexcept;
+        const_reference operator [] (size_type index) const noexcept;
+        reference at(size_type index);
+        const_reference at(size_type index) const;
+        reference front() noexcept;
+        const_reference front() const noexcept;
+        reference back() noexcept;
+        const_reference back() const noexcept;
+
+        //access column: data<I>() is 64-byte aligned and size() long
+        template <size_type I>
+        field_type<I> *data() noexcept;
+        template <size_type I>
+        const field_type<I> *data() const noexcept;
+        template <size_type I>
+        Span<field_type<I>> column() noexcept
+        { return Span<field_type<I>>{std::get<I>(cols), theSize}; }
+        template <size_type I>
+        Span<const field_type<I>> column() const noexcept
+        { return Span<const field_type<I>>{std::get<I>(cols), theSize}; }
+
+        //iterator
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+        //capacity
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+        size_type capacity() const noexcept;
+        void reserve(size_type newCapacity);
+        void shrink_to_fit();
+
+        //update
+        void clear() noexcept;
+        void push_back(const value_type &value);
+        void push_back(value_type &&value);
+        template <typename... Args>
+        reference emplace_back(Args &&... args);
+        void pop_back() noexcept;
+        iterator insert(const_iterator pos, const value_type &value);
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args);
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+        void resize(size_type count);
+        void resize(size_type count, const Fields &... values);
+        void swap(SoAVector &other) noexcept;
+
+    private:
+        struct alignas(64) Line {
+            unsigned char bytes[64];
+        };
+
+        Line *buffer;
+        std::tuple<Fields *...> cols;
+        size_type theSize;
+        size_type theCapacity;
+
+        template <typename F>
+        static void for_each_column(F &&f);
+        template <typename F, std::size_t... I>
+        static void for_each_column(F &f, std::index_sequence<I...>);
+
+        static size_type lines_for(size_type count) noexcept;
+        void reallocate(size_type newCapacity);
+        template <typename Tuple, std::size_t... I>
+        void construct_row(size_type row, Tuple &&values, std::index_sequence<I...>);
+        void destroy_rows(size_type first, size_type last) noexcept;
+        void grow_for(size_type count);
+    };
+
+    template <typename... Fields>
+    SoAVector<Fields...>::SoAVector() noexcept
+        : buffer{nullptr}, cols{}, theSize{0}, theCapacity{0}
+    { }
+
+    template <typename... Fields>
+    SoAVector<Fields...>::SoAVector(size_type count)
+        : SoAVector()
+    { resize(count); }
+
+    template <typename... Fields>
+    SoAVector<Fields...>::SoAVector(size_type count, const Fields &... values)
+        : SoAVector()
+    { resize(count, values...); }
+
+    template <typename... Fields>
+    SoAVector<Fields...>::SoAVector(std::initializer_list<value_type> ilist)
+        : SoAVector()
+    {
+        reserve(ilist.size());
+        for (const value_type &value : ilist) {
+            push_back(value);
+        }
+    }
+
+    template <typename... Fields>
+    SoAVector<Fields...>::SoAVector(const SoAVector &other)
+        : SoAVector()
+    {
+        reserve(other.size());
+        for (size_type i = 0; i < other.size(); ++i) {
+            push_back(static_cast<value_type>(other[i]));
+        }
+    }
+
+    template <typename... Fields>
+    SoAVector<Fields...>::SoAVector(SoAVector &&other) noexcept
+        : SoAVector()
+    { swap(other); }
+
+    template <typename... Fields>
+    SoAVector<Fields...>::~SoAVector()
+    {
+        clear();
+        std::allocator<Line>{}.deallocate(buffer, lines_for(theCapacity));
+    }
+
+    template <typename... Fields>
+    SoAVector<Fields...> &SoAVector<Fields...>::operator = (const SoAVector &other)
+    {
+        if (this != &other) {
+            SoAVector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename... Fields>
+    SoAVector<Fields...> &SoAVector<Fields...>::operator = (SoAVector &&other) noexcept
+    {
+        if (this != &other) {
+            SoAVector moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::reference SoAVector<Fields...>::operator [] (size_type index) noexcept
+    { return reference{this, index}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_reference SoAVector<Fields...>::operator [] (size_type index) const noexcept
+    { return const_reference{this, index}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::reference SoAVector<Fields...>::at(size_type index)
+    {
+        if (index >= theSize) {
+            throw std::out_of_range{"sp::SoAVector::at"};
+        }
+        return reference{this, index};
+    }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_reference SoAVector<Fields...>::at(size_type index) const
+    {
+        if (index >= theSize) {
+            throw std::out_of_range{"sp::SoAVector::at"};
+        }
+        return const_reference{this, index};
+    }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::reference SoAVector<Fields...>::front() noexcept
+    { return reference{this, 0}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_reference SoAVector<Fields...>::front() const noexcept
+    { return const_reference{this, 0}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::reference SoAVector<Fields...>::back() noexcept
+    { return reference{this, theSize - 1}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_reference SoAVector<Fields...>::back() const noexcept
+    { return const_reference{this, theSize - 1}; }
+
+    template <typename... Fields>
+    template <typename SoAVector<Fields...>::size_type I>
+    typename SoAVector<Fields...>::template field_type<I> *SoAVector<Fields...>::data() noexcept
+    { return std::get<I>(cols); }
+
+    template <typename... Fields>
+    template <typename SoAVector<Fields...>::size_type I>
+    const typename SoAVector<Fields...>::template field_type<I> *SoAVector<Fields...>::data() const noexcept
+    { return std::get<I>(cols); }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::iterator SoAVector<Fields...>::begin() noexcept
+    { return iterator{this, 0}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::iterator SoAVector<Fields...>::end() noexcept
+    { return iterator{this, theSize}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_iterator SoAVector<Fields...>::begin() const noexcept
+    { return const_iterator{this, 0}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_iterator SoAVector<Fields...>::end() const noexcept
+    { return const_iterator{this, theSize}; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_iterator SoAVector<Fields...>::cbegin() const noexcept
+    { return begin(); }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::const_iterator SoAVector<Fields...>::cend() const noexcept
+    { return end(); }
+
+    template <typename... Fields>
+    bool SoAVector<Fields...>::empty() const noexcept
+    { return theSize == 0; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::size_type SoAVector<Fields...>::size() const noexcept
+    { return theSize; }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::size_type SoAVector<Fields...>::capacity() const noexcept
+    { return theCapacity; }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::reserve(size_type newCapacity)
+    {
+        if (newCapacity > theCapacity) {
+            reallocate(newCapacity);
+        }
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::shrink_to_fit()
+    {
+        if (theSize < theCapacity) {
+            reallocate(theSize);
+        }
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::clear() noexcept
+    {
+        destroy_rows(0, theSize);
+        theSize = 0;
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::push_back(const value_type &value)
+    {
+        grow_for(theSize + 1);
+        construct_row(theSize, value, std::make_index_sequence<columns>{});
+        ++theSize;
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::push_back(value_type &&value)
+    {
+        grow_for(theSize + 1);
+        construct_row(theSize, std::move(value), std::make_index_sequence<columns>{});
+        ++theSize;
+    }
+
+    //one argument per column
+    template <typename... Fields>
+    template <typename... Args>
+    typename SoAVector<Fields...>::reference SoAVector<Fields...>::emplace_back(Args &&... args)
+    {
+        static_assert(sizeof...(Args) == columns, "emplace_back takes one argument per field");
+        grow_for(theSize + 1);
+        construct_row(theSize, std::forward_as_tuple(std::forward<Args>(args)...), std::make_index_sequence<columns>{});
+        return reference{this, theSize++};
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::pop_back() noexcept
+    {
+        destroy_rows(theSize - 1, theSize);
+        --theSize;
+    }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::iterator SoAVector<Fields...>::insert(const_iterator pos, const value_type &value)
+    {
+        size_type row = pos.index();
+        push_back(value);
+        for_each_column([this, row](auto column) {
+            auto *p = std::get<decltype(column)::value>(cols);
+            std::rotate(p + row, p + theSize - 1, p + theSize);
+        });
+        return iterator{this, row};
+    }
+
+    template <typename... Fields>
+    template <typename... Args>
+    typename SoAVector<Fields...>::iterator SoAVector<Fields...>::emplace(const_iterator pos, Args &&... args)
+    {
+        size_type row = pos.index();
+        emplace_back(std::forward<Args>(args)...);
+        for_each_column([this, row](auto column) {
+            auto *p = std::get<decltype(column)::value>(cols);
+            std::rotate(p + row, p + theSize - 1, p + theSize);
+        });
+        return iterator{this, row};
+    }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::iterator SoAVector<Fields...>::erase(const_iterator pos)
+    { return erase(pos, pos + 1); }
+
+    template <typename... Fields>
+    typename SoAVector<Fields...>::iterator SoAVector<Fields...>::erase(const_iterator first, const_iterator last)
+    {
+        size_type from = first.index(), to = last.index();
+        if (from != to) {
+            for_each_column([this, from, to](auto column) {
+                auto *p = std::get<decltype(column)::value>(cols);
+                std::move(p + to, p + theSize, p + from);
+            });
+            destroy_rows(theSize - (to - from), theSize);
+            theSize -= to - from;
+        }
+        return iterator{this, from};
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::resize(size_type count)
+    { resize(count, Fields{}...); }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::resize(size_type count, const Fields &... values)
+    {
+        if (count < theSize) {
+            destroy_rows(count, theSize);
+            theSize = count;
+            return;
+        }
+        reserve(count);
+        while (theSize < count) {
+            construct_row(theSize, std::forward_as_tuple(values...), std::make_index_sequence<columns>{});
+            ++theSize;
+        }
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::swap(SoAVector &other) noexcept
+    {
+        std::swap(buffer, other.buffer);
+        std::swap(cols, other.cols);
+        std::swap(theSize, other.theSize);
+        std::swap(theCapacity, other.theCapacity);
+    }
+
+    template <typename... Fields>
+    template <typename F>
+    void SoAVector<Fields...>::for_each_column(F &&f)
+    { for_each_column(f, std::make_index_sequence<columns>{}); }
+
+    //calls f(integral_constant<size_t, I>) for every column I
+    template <typename... Fields>
+    template <typename F, std::size_t... I>
+    void SoAVector<Fields...>::for_each_column(F &f, std::index_sequence<I...>)
+    { (f(std::integral_constant<std::size_t, I>{}), ...); }
+
+    //64-byte lines needed for count rows, every column rounded up to whole lines
+    template <typename... Fields>
+    typename SoAVector<Fields...>::size_type SoAVector<Fields...>::lines_for(size_type count) noexcept
+    { return (((count * sizeof(Fields) + sizeof(Line) - 1) / sizeof(Line)) + ... + 0); }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::reallocate(size_type newCapacity)
+    {
+        static_assert(((alignof(Fields) <= sizeof(Line)) && ...), "fields must not be aligned past 64 bytes");
+
+        std::allocator<Line> lineAlloc;
+        Line *newBuffer = newCapacity ? lineAlloc.allocate(lines_for(newCapacity)) : nullptr;
+        std::tuple<Fields *...> newCols;
+        Line *at = newBuffer;
+        for_each_column([&](auto column) {
+            constexpr std::size_t I = decltype(column)::value;
+            std::get<I>(newCols) = reinterpret_cast<field_type<I> *>(at);
+            at += (newCapacity * sizeof(field_type<I>) + sizeof(Line) - 1) / sizeof(Line);
+        });
+
+        //relocate column by column; a throwing copy undoes the columns already done
+        std::size_t done = 0;
+        try {
+            for_each_column([&](auto column) {
+                constexpr std::size_t I = decltype(column)::value;
+                typedef field_type<I> F;
+                F *from = std::get<I>(cols);
+                if constexpr (std::is_nothrow_move_constructible<F>::value || !std::is_copy_constructible<F>::value) {
+                    std::uninitialized_move(from, from + theSize, std::get<I>(newCols));
+                }
+                else {
+                    std::uninitialized_copy(from, from + theSize, std::get<I>(newCols));
+                }
+                ++done;
+            });
+        }
+        catch (...) {
+            for_each_column([&](auto column) {
+                constexpr std::size_t I = decltype(column)::value;
+                if (I < done) {
+                    std::destroy(std::get<I>(newCols), std::get<I>(newCols) + theSize);
+                }
+            });
+            lineAlloc.deallocate(newBuffer, lines_for(newCapacity));
+            throw;
+        }
+
+        destroy_rows(0, theSize);
+        lineAlloc.deallocate(buffer, lines_for(theCapacity));
+        buffer = newBuffer;
+        cols = newCols;
+        theCapacity = newCapacity;
+    }
+
+    //constructs field I of the row from get<I>(values); if one column throws the columns already
+    //built for this row are destroyed, so the columns never go out of step
+    template <typename... Fields>
+    template <typename Tuple, std::size_t... I>
+    void SoAVector<Fields...>::construct_row(size_type row, Tuple &&values, std::index_sequence<I...>)
+    {
+        std::size_t built = 0;
+        try {
+            ((::new (static_cast<void *>(std::get<I>(cols) + row)) field_type<I>(std::get<I>(std::forward<Tuple>(values))),
+              ++built), ...);
+        }
+        catch (...) {
+            for_each_column([&](auto column) {
+                constexpr std::size_t J = decltype(column)::value;
+                if (J < built) {
+                    std::destroy_at(std::get<J>(cols) + row);
+                }
+            });
+            throw;
+        }
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::destroy_rows(size_type first, size_type last) noexcept
+    {
+        for_each_column([&](auto column) {
+            auto *p = std::get<decltype(column)::value>(cols);
+            std::destroy(p + first, p + last);
+        });
+    }
+
+    template <typename... Fields>
+    void SoAVector<Fields...>::grow_for(size_type count)
+    {
+        if (count > theCapacity) {
+            reallocate(std::max(count, theCapacity ? 2 * theCapacity : size_type{8}));
+        }
+    }
+
+    template <typename... Fields>
+    bool operator == (const SoAVector<Fields...> &lhs, const SoAVector<Fields...> &rhs)
+    {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (typename SoAVector<Fields...>::size_type i = 0; i < lhs.size(); ++i) {
+            if (static_cast<std::tuple<Fields...>>(lhs[i]) != static_cast<std::tuple<Fields...>>(rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename... Fields>
+    bool operator != (const SoAVector<Fields...> &lhs, const SoAVector<Fields...> &rhs)
+    { return !(lhs == rhs); }
+
+} //namespace sp
+
+//structured bindings over rows: auto [x, y] = soa[i]; binds references into the columns
+namespace std {
+
+    template <typename Owner, bool Const>
+    struct tuple_size<sp::SoARow<Owner, Const>> : integral_constant<size_t, Owner::columns> {
+    };
+
+    template <size_t I, typename Owner, bool Const>
+    struct tuple_element<I, sp::SoARow<Owner, Const>> {
+        typedef typename sp::SoARow<Owner, Const>::template field_type<I> &type;
+    };
+
+} //namespace std
+
+#endif //SP_SOA_VECTOR__H
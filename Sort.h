@@ -0,0 +1,574 @@
+//Created by sphc on 2026/10/19
+//Sort.h
+//
+
+#ifndef SP_SORT__H
+#define SP_SORT__H
+
+#include <cstddef> //size_t, ptrdiff_t
+#include <cstdint> //uint8_t, uint32_t, uint64_t
+#include <cstring> //memcpy
+#include <algorithm> //iter_swap, move
+#include <memory> //allocator_traits, uninitialized_move
+#include <functional> //less, greater
+#include <iterator> //iterator_traits
+#include <type_traits> //is_integral, is_floating_point, make_unsigned
+#include <utility> //move, swap
+#include "Vector.h"
+
+namespace sp {
+
+    namespace detail {
+
+        //uninitialized memory from a container's allocator, released on scope exit
+        template <typename T, typename Allocator>
+        class ScratchBuffer {
+        public:
+            typedef typename std::allocator_traits<Allocator>::template rebind_alloc<T> allocator_type;
+            typedef std::allocator_traits<allocator_type> traits;
+
+            ScratchBuffer(std::size_t count, const Allocator &allocator)
+                : alloc{allocator}, start{traits::allocate(alloc, count)}, count{count}, constructed{0}
+            { }
+
+            ScratchBuffer(const ScratchBuffer &) = delete;
+            ScratchBuffer &operator = (const ScratchBuffer &) = delete;
+
+            ~ScratchBuffer()
+            {
+                destroy();
+                traits::deallocate(alloc, start, count);
+            }
+
+            T *data() noexcept
+            { return start; }
+
+            std::size_t size() const noexcept
+            { return count; }
+
+            //non-trivial types need live objects to move-assign into, so move src's elements
+            //here first; returns true if it did, in which case the buffer holds the data
+            bool construct_from(T *src, std::size_t n)
+            {
+                if (std::is_trivially_copyable<T>::value) {
+                    return false;
+                }
+                std::uninitialized_move(src, src + n, start);
+                constructed = n;
+                return true;
+            }
+
+            void destroy()
+            {
+                while (constructed) {
+                    traits::destroy(alloc, start + --constructed);
+                }
+            }
+
+        private:
+            allocator_type alloc;
+            T *start;
+            std::size_t count;
+            std::size_t constructed;
+        };
+
+        //maps a radix key to an unsigned integer with the same ordering
+        template <typename Key, typename = void>
+        struct RadixTraits {
+            static constexpr bool value = false;
+        };
+
+        template <typename Key>
+        struct RadixTraits<Key, typename std::enable_if<std::is_integral<Key>::value && !std::is_same<Key, bool>::value>::type> {
+            static constexpr bool value = true;
+            typedef typename std::make_unsigned<Key>::type bits_type;
+
+            static bits_type encode(Key key) noexcept
+            {
+                bits_type bits = static_cast<bits_type>(key);
+                if (std::is_signed<Key>::value) {
+                    bits ^= bits_type{1} << (sizeof(Key) * 8 - 1);
+                }
+                return bits;
+            }
+        };
+
+        template <typename Key>
+        struct RadixTraits<Key, typename std::enable_if<std::is_floating_point<Key>::value
+                                                        && (sizeof(Key) == 4 || sizeof(Key) == 8)>::type> {
+            static constexpr bool value = true;
+            typedef typename std::conditional<sizeof(Key) == 4, std::uint32_t, std::uint64_t>::type bits_type;
+
+            //negative values flip every bit, positive values only the sign bit
+            static bits_type encode(Key key) noexcept
+            {
+                bits_type bits;
+                std::memcpy(&bits, &key, sizeof(Key));
+                bits_type sign = bits_type{1} << (sizeof(Key) * 8 - 1);
+                return (bits & sign) ? ~bits : bits ^ sign;
+            }
+        };
+
+        template <typename Compare, typename T>
+        struct IsDefaultLess : std::integral_constant<bool,
+            std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::less<>>::value> { };
+
+        template <typename Compare, typename T>
+        struct IsDefaultGreater : std::integral_constant<bool,
+            std::is_same<Compare, std::greater<T>>::value || std::is_same<Compare, std::greater<>>::value> { };
+
+        constexpr std::ptrdiff_t insertionSortThreshold = 24;
+        constexpr std::ptrdiff_t nintherThreshold = 128;
+        constexpr std::ptrdiff_t partialInsertionSortLimit = 8;
+        constexpr std::size_t radixThreshold = 256;
+        constexpr std::size_t radixBits = 11;
+        constexpr std::size_t radixBuckets = std::size_t{1} << radixBits;
+        constexpr std::size_t mergeRunLength = 32;
+
+        template <typename Iterator, typename Compare>
+        void insertion_sort(Iterator first, Iterator last, Compare comp)
+        {
+            typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+            if (first == last) {
+                return;
+            }
+            for (Iterator cur = first + 1; cur != last; ++cur) {
+                Iterator sift = cur, prev = cur - 1;
+                if (comp(*sift, *prev)) {
+                    value_type tmp = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*prev);
+                    } while (sift != first && comp(tmp, *--prev));
+                    *sift = std::move(tmp);
+                }
+            }
+        }
+
+        //insertion sort that assumes *(first - 1) is a sentinel no greater than any element
+        template <typename Iterator, typename Compare>
+        void unguarded_insertion_sort(Iterator first, Iterator last, Compare comp)
+        {
+            typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+            if (first == last) {
+                return;
+            }
+            for (Iterator cur = first + 1; cur != last; ++cur) {
+                Iterator sift = cur, prev = cur - 1;
+                if (comp(*sift, *prev)) {
+                    value_type tmp = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*prev);
+                    } while (comp(tmp, *--prev));
+                    *sift = std::move(tmp);
+                }
+            }
+        }
+
+        //gives up after partialInsertionSortLimit moves, returns whether the range got sorted
+        template <typename Iterator, typename Compare>
+        bool partial_insertion_sort(Iterator first, Iterator last, Compare comp)
+        {
+            typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+            if (first == last) {
+                return true;
+            }
+            std::ptrdiff_t moves = 0;
+            for (Iterator cur = first + 1; cur != last; ++cur) {
+                Iterator sift = cur, prev = cur - 1;
+                if (comp(*sift, *prev)) {
+                    value_type tmp = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*prev);
+                    } while (sift != first && comp(tmp, *--prev));
+                    *sift = std::move(tmp);
+                    moves += cur - sift;
+                }
+                if (moves > partialInsertionSortLimit) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename Iterator, typename Compare>
+        void sort2(Iterator a, Iterator b, Compare comp)
+        {
+            if (comp(*b, *a)) {
+                std::iter_swap(a, b);
+            }
+        }
+
+        template <typename Iterator, typename Compare>
+        void sort3(Iterator a, Iterator b, Iterator c, Compare comp)
+        {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        template <typename Iterator, typename Compare>
+        void sift_down(Iterator first, std::ptrdiff_t hole, std::ptrdiff_t len, Compare comp)
+        {
+            typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+            value_type tmp = std::move(first[hole]);
+            std::ptrdiff_t child;
+            while ((child = 2 * hole + 1) < len) {
+                if (child + 1 < len && comp(first[child], first[child + 1])) {
+                    ++child;
+                }
+                if (!comp(tmp, first[child])) {
+                    break;
+                }
+                first[hole] = std::move(first[child]);
+                hole = child;
+            }
+            first[hole] = std::move(tmp);
+        }
+
+        template <typename Iterator, typename Compare>
+        void heap_sort(Iterator first, Iterator last, Compare comp)
+        {
+            std::ptrdiff_t len = last - first;
+            for (std::ptrdiff_t i = len / 2; i-- > 0; ) {
+                sift_down(first, i, len, comp);
+            }
+            while (len > 1) {
+                std::iter_swap(first, first + --len);
+                sift_down(first, 0, len, comp);
+            }
+        }
+
+        //partitions around *first, equal elements go right; returns the pivot position and
+        //whether the range was already partitioned
+        template <typename Iterator, typename Compare>
+        std::pair<Iterator, bool> partition_right(Iterator first, Iterator last, Compare comp)
+        {
+            typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+            value_type pivot = std::move(*first);
+            Iterator left = first, right = last;
+
+            while (comp(*++left, pivot)) { }
+            if (left - 1 == first) {
+                while (left < right && !comp(*--right, pivot)) { }
+            }
+            else {
+                while (!comp(*--right, pivot)) { }
+            }
+
+            bool alreadyPartitioned = left >= right;
+            while (left < right) {
+                std::iter_swap(left, right);
+                while (comp(*++left, pivot)) { }
+                while (!comp(*--right, pivot)) { }
+            }
+
+            Iterator pivotPos = left - 1;
+            *first = std::move(*pivotPos);
+            *pivotPos = std::move(pivot);
+
+            return std::pair<Iterator, bool>{pivotPos, alreadyPartitioned};
+        }
+
+        //partitions around *first, equal elements go left; used when many keys repeat
+        template <typename Iterator, typename Compare>
+        Iterator partition_left(Iterator first, Iterator last, Compare comp)
+        {
+            typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+            value_type pivot = std::move(*first);
+            Iterator left = first, right = last;
+
+            while (comp(pivot, *--right)) { }
+            if (right + 1 == last) {
+                while (left < right && !comp(pivot, *++left)) { }
+            }
+            else {
+                while (!comp(pivot, *++left)) { }
+            }
+
+            while (left < right) {
+                std::iter_swap(left, right);
+                while (comp(pivot, *--right)) { }
+                while (!comp(pivot, *++left)) { }
+            }
+
+            *first = std::move(*right);
+            *right = std::move(pivot);
+
+            return right;
+        }
+
+        template <typename Iterator, typename Compare>
+        void pdq_loop(Iterator first, Iterator last, Compare comp, int badAllowed, bool leftmost)
+        {
+            while (true) {
+                std::ptrdiff_t len = last - first;
+
+                if (len < insertionSortThreshold) {
+                    if (leftmost) {
+                        insertion_sort(first, last, comp);
+                    }
+                    else {
+                        unguarded_insertion_sort(first, last, comp);
+                    }
+                    return;
+                }
+
+                //move the pivot to *first
+                std::ptrdiff_t half = len / 2;
+                if (len > nintherThreshold) {
+                    sort3(first, first + half, last - 1, comp);
+                    sort3(first + 1, first + (half - 1), last - 2, comp);
+                    sort3(first + 2, first + (half + 1), last - 3, comp);
+                    sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    std::iter_swap(first, first + half);
+                }
+                else {
+                    sort3(first + half, first, last - 1, comp);
+                }
+
+                //the element before this range is the pivot of a previous partition, so if it
+                //equals our pivot every element here is >= it: peel off the run of equals
+                if (!leftmost && !comp(*(first - 1), *first)) {
+                    first = partition_left(first, last, comp) + 1;
+                    continue;
+                }
+
+                std::pair<Iterator, bool> part = partition_right(first, last, comp);
+                Iterator pivotPos = part.first;
+                std::ptrdiff_t leftLen = pivotPos - first;
+                std::ptrdiff_t rightLen = last - (pivotPos + 1);
+
+                if (leftLen < len / 8 || rightLen < len / 8) {
+                    //unbalanced: break up the pattern that caused it, fall back to heap sort if it persists
+                    if (--badAllowed == 0) {
+                        heap_sort(first, last, comp);
+                        return;
+                    }
+                    if (leftLen >= insertionSortThreshold) {
+                        std::iter_swap(first, first + leftLen / 4);
+                        std::iter_swap(pivotPos - 1, pivotPos - leftLen / 4);
+                        if (leftLen > nintherThreshold) {
+                            std::iter_swap(first + 1, first + (leftLen / 4 + 1));
+                            std::iter_swap(first + 2, first + (leftLen / 4 + 2));
+                            std::iter_swap(pivotPos - 2, pivotPos - (leftLen / 4 + 1));
+                            std::iter_swap(pivotPos - 3, pivotPos - (leftLen / 4 + 2));
+                        }
+                    }
+                    if (rightLen >= insertionSortThreshold) {
+                        std::iter_swap(pivotPos + 1, pivotPos + (1 + rightLen / 4));
+                        std::iter_swap(last - 1, last - rightLen / 4);
+                        if (rightLen > nintherThreshold) {
+                            std::iter_swap(pivotPos + 2, pivotPos + (2 + rightLen / 4));
+                            std::iter_swap(pivotPos + 3, pivotPos + (3 + rightLen / 4));
+                            std::iter_swap(last - 2, last - (1 + rightLen / 4));
+                            std::iter_swap(last - 3, last - (2 + rightLen / 4));
+                        }
+                    }
+                }
+                else if (part.second
+                         && partial_insertion_sort(first, pivotPos, comp)
+                         && partial_insertion_sort(pivotPos + 1, last, comp)) {
+                    //balanced and no swaps needed: the input was probably (nearly) sorted
+                    return;
+                }
+
+                //recurse into the left part, loop on the right one
+                pdq_loop(first, pivotPos, comp, badAllowed, leftmost);
+                first = pivotPos + 1;
+                leftmost = false;
+            }
+        }
+
+        template <typename Iterator, typename Compare>
+        void pdq_sort(Iterator first, Iterator last, Compare comp)
+        {
+            std::ptrdiff_t len = last - first;
+            int log2 = 0;
+            while (len >>= 1) {
+                ++log2;
+            }
+            pdq_loop(first, last, comp, log2, true);
+        }
+
+        //LSD radix sort on 11-bit digits, ping-ponging between the data and a scratch buffer
+        template <typename T, typename Allocator, typename KeyExtractor>
+        void radix_sort(Vector<T, Allocator> &v, KeyExtractor key, bool descending)
+        {
+            typedef typename std::decay<decltype(key(std::declval<const T &>()))>::type key_type;
+            typedef RadixTraits<key_type> traits;
+            typedef typename traits::bits_type bits_type;
+            constexpr std::size_t passes = (sizeof(bits_type) * 8 + radixBits - 1) / radixBits;
+
+            std::size_t n = v.size();
+            if (n < radixThreshold) {
+                if (descending) {
+                    pdq_sort(v.begin(), v.end(), [&key](const T &a, const T &b) { return key(b) < key(a); });
+                }
+                else {
+                    pdq_sort(v.begin(), v.end(), [&key](const T &a, const T &b) { return key(a) < key(b); });
+                }
+                return;
+            }
+
+            bits_type flip = descending ? static_cast<bits_type>(~bits_type{0}) : bits_type{0};
+
+            //one read pass builds every digit's histogram
+            Vector<std::size_t> counts(passes * radixBuckets, 0);
+            for (const T &x : v) {
+                bits_type bits = traits::encode(key(x)) ^ flip;
+                for (std::size_t p = 0; p < passes; ++p) {
+                    ++counts[p * radixBuckets + ((bits >> (p * radixBits)) & (radixBuckets - 1))];
+                }
+            }
+            bits_type firstBits = traits::encode(key(v.front())) ^ flip;
+
+            ScratchBuffer<T, Allocator> scratch{n, v.get_allocator()};
+            T *src = v.data(), *dst = scratch.data();
+            if (scratch.construct_from(src, n)) {
+                std::swap(src, dst);
+            }
+
+            for (std::size_t p = 0; p < passes; ++p) {
+                std::size_t *count = counts.data() + p * radixBuckets;
+                //all keys share this digit, the pass would be an identity permutation
+                if (count[(firstBits >> (p * radixBits)) & (radixBuckets - 1)] == n) {
+                    continue;
+                }
+
+                std::size_t sum = 0;
+                for (std::size_t d = 0; d < radixBuckets; ++d) {
+                    std::size_t c = count[d];
+                    count[d] = sum;
+                    sum += c;
+                }
+                for (T *it = src; it != src + n; ++it) {
+                    bits_type bits = traits::encode(key(*it)) ^ flip;
+                    dst[count[(bits >> (p * radixBits)) & (radixBuckets - 1)]++] = std::move(*it);
+                }
+                std::swap(src, dst);
+            }
+
+            if (src != v.data()) {
+                std::move(src, src + n, v.data());
+            }
+        }
+
+        //merges [first, mid) and [mid, last) of src into dst
+        template <typename T, typename Compare>
+        void merge_runs(T *src, std::size_t first, std::size_t mid, std::size_t last, T *dst, Compare comp)
+        {
+            std::size_t i = first, j = mid, k = first;
+            while (i < mid && j < last) {
+                if (comp(src[j], src[i])) {
+                    dst[k++] = std::move(src[j++]);
+                }
+                else {
+                    dst[k++] = std::move(src[i++]);
+                }
+            }
+            while (i < mid) {
+                dst[k++] = std::move(src[i++]);
+            }
+            while (j < last) {
+                dst[k++] = std::move(src[j++]);
+            }
+        }
+
+        //bottom-up merge sort: insertion-sorted runs, then ping-pong merges through the scratch buffer
+        template <typename T, typename Allocator, typename Compare>
+        void merge_sort(Vector<T, Allocator> &v, Compare comp)
+        {
+            std::size_t n = v.size();
+            T *data = v.data();
+
+            for (std::size_t first = 0; first < n; first += mergeRunLength) {
+                std::size_t last = first + mergeRunLength < n ? first + mergeRunLength : n;
+                insertion_sort(data + first, data + last, comp);
+            }
+            if (n <= mergeRunLength) {
+                return;
+            }
+
+            ScratchBuffer<T, Allocator> scratch{n, v.get_allocator()};
+            T *src = data, *dst = scratch.data();
+            if (scratch.construct_from(src, n)) {
+                std::swap(src, dst);
+            }
+
+            for (std::size_t width = mergeRunLength; width < n; width *= 2) {
+                for (std::size_t first = 0; first < n; first += 2 * width) {
+                    std::size_t mid = first + width < n ? first + width : n;
+                    std::size_t last = first + 2 * width < n ? first + 2 * width : n;
+                    merge_runs(src, first, mid, last, dst, comp);
+                }
+                std::swap(src, dst);
+            }
+
+            if (src != data) {
+                std::move(src, src + n, data);
+            }
+        }
+
+        struct Identity {
+            template <typename T>
+            const T &operator () (const T &x) const noexcept
+            { return x; }
+        };
+
+    } //namespace detail
+
+    //true if T can be ordered by LSD radix sort directly
+    template <typename T>
+    struct is_radix_sortable : std::integral_constant<bool, detail::RadixTraits<T>::value> { };
+
+    //LSD radix sort on key(element); key must return an integral or floating point value
+    template <typename T, typename Allocator, typename KeyExtractor>
+    void radix_sort(Vector<T, Allocator> &v, KeyExtractor key)
+    {
+        static_assert(detail::RadixTraits<typename std::decay<decltype(key(std::declval<const T &>()))>::type>::value,
+                      "radix_sort key must be an integral or floating point type");
+        detail::radix_sort(v, key, false);
+    }
+
+    template <typename T, typename Allocator>
+    void radix_sort(Vector<T, Allocator> &v)
+    { radix_sort(v, detail::Identity{}); }
+
+    //unstable sort; integral and floating point elements with std::less or std::greater use
+    //radix sort, everything else uses pattern-defeating introsort
+    template <typename T, typename Allocator, typename Compare>
+    void sort(Vector<T, Allocator> &v, Compare comp)
+    {
+        if constexpr (is_radix_sortable<T>::value && detail::IsDefaultLess<Compare, T>::value) {
+            detail::radix_sort(v, detail::Identity{}, false);
+        }
+        else if constexpr (is_radix_sortable<T>::value && detail::IsDefaultGreater<Compare, T>::value) {
+            detail::radix_sort(v, detail::Identity{}, true);
+        }
+        else {
+            detail::pdq_sort(v.begin(), v.end(), comp);
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void sort(Vector<T, Allocator> &v)
+    { sort(v, std::less<T>{}); }
+
+    //stable merge sort
+    template <typename T, typename Allocator, typename Compare>
+    void stable_sort(Vector<T, Allocator> &v, Compare comp)
+    { detail::merge_sort(v, comp); }
+
+    template <typename T, typename Allocator>
+    void stable_sort(Vector<T, Allocator> &v)
+    { stable_sort(v, std::less<T>{}); }
+
+} //namespace sp
+
+#endif //SP_SORT__H
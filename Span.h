@@ -0,0 +1,82 @@
+//Created by sphc on 2026/10/19
+//Span.h
+//
+
+#ifndef SP_SPAN__H
+#define SP_SPAN__H
+
+#include <cstddef> //size_t, ptrdiff_t
+#include <stdexcept> //out_of_range
+
+namespace sp {
+
+    //non-owning view of count contiguous T, for handing columns and rows of sp containers to
+    //loops and SIMD kernels
+    template <typename T>
+    class Span {
+    public:
+        typedef T element_type;
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T &reference;
+        typedef T *pointer;
+        typedef T *iterator;
+
+        constexpr Span() noexcept
+            : first{nullptr}, count{0}
+        { }
+
+        constexpr Span(T *data, size_type size) noexcept
+            : first{data}, count{size}
+        { }
+
+        //Span<T> converts to Span<const T>
+        template <typename U>
+        constexpr Span(const Span<U> &other) noexcept
+            : first{other.data()}, count{other.size()}
+        { }
+
+        constexpr T *data() const noexcept
+        { return first; }
+
+        constexpr size_type size() const noexcept
+        { return count; }
+
+        constexpr bool empty() const noexcept
+        { return count == 0; }
+
+        constexpr T *begin() const noexcept
+        { return first; }
+
+        constexpr T *end() const noexcept
+        { return first + count; }
+
+        constexpr T &operator [] (size_type index) const
+        { return first[index]; }
+
+        T &at(size_type index) const
+        {
+            if (index >= count) {
+                throw std::out_of_range{"sp::Span::at"};
+            }
+            return first[index];
+        }
+
+        constexpr T &front() const
+        { return *first; }
+
+        constexpr T &back() const
+        { return first[count - 1]; }
+
+        constexpr Span subspan(size_type offset, size_type length) const
+        { return Span{first + offset, length}; }
+
+    private:
+        T *first;
+        size_type count;
+    };
+
+} //namespace sp
+
+#endif //SP_SPAN__H
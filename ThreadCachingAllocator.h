@@ -0,0 +1,350 @@
+//Created by sphc on 2026/10/19
+//ThreadCachingAllocator.h
+//
+
+#ifndef SP_THREAD_CACHING_ALLOCATOR__H
+#define SP_THREAD_CACHING_ALLOCATOR__H
+
+#include <cstddef> //size_t, ptrdiff_t
+#include <mutex> //mutex, lock_guard
+#include <new> //operator new, bad_alloc, bad_array_new_length, align_val_t
+#include <type_traits> //true_type
+#include <vector> //vector
+#include <sys/mman.h> //mmap
+
+namespace sp {
+
+    namespace detail {
+
+        //small requests are rounded up to one of 40 size classes: 16 to 128 bytes in steps of 16,
+        //then four classes per power of two up to 32 KB. Every class is a multiple of 16 bytes.
+        constexpr std::size_t cacheAlignment = 16;
+        constexpr std::size_t maxCachedBytes = 32768;
+        constexpr std::size_t sizeClasses = 40;
+        constexpr std::size_t chunkBytes = 65536; //refill unit taken from the page heap
+        constexpr std::size_t regionBytes = 4 << 20; //page heap mapping unit
+
+        inline std::size_t size_class(std::size_t bytes) noexcept
+        {
+            if (bytes <= 128) {
+                return bytes ? (bytes - 1) / 16 : 0;
+            }
+            std::size_t lg = 63 - static_cast<std::size_t>(__builtin_clzll(bytes - 1));
+            return 8 + (lg - 7) * 4 + ((bytes - 1 - (std::size_t{1} << lg)) >> (lg - 2));
+        }
+
+        inline std::size_t class_bytes(std::size_t index) noexcept
+        {
+            if (index < 8) {
+                return (index + 1) * 16;
+            }
+            std::size_t lg = 7 + (index - 8) / 4;
+            return (std::size_t{1} << lg) + ((index - 8) % 4 + 1) * (std::size_t{1} << (lg - 2));
+        }
+
+        //objects moved between a thread cache and the central lists at a time
+        inline std::size_t batch_objects(std::size_t index) noexcept
+        {
+            std::size_t n = chunkBytes / class_bytes(index);
+            return n < 2 ? 2 : n > 64 ? 64 : n;
+        }
+
+        struct FreeObject {
+            FreeObject *next;
+        };
+
+        struct Batch {
+            FreeObject *head;
+            std::size_t count;
+        };
+
+        //shared by all threads: one locked list of batches per size class, fed by a page heap that
+        //carves mmap regions. Memory is reused but never returned to the system; the heap itself is
+        //never destroyed, so containers with static storage duration can free into it at exit.
+        class CentralHeap {
+        public:
+            static CentralHeap &get()
+            {
+                static CentralHeap *heap = new CentralHeap;
+                return *heap;
+            }
+
+            Batch fetch(std::size_t index)
+            {
+                Central &c = classes[index];
+                {
+                    std::lock_guard<std::mutex> lock{c.mutex};
+                    if (!c.batches.empty()) {
+                        Batch b = c.batches.back();
+                        c.batches.pop_back();
+                        return b;
+                    }
+                }
+                return carve(index);
+            }
+
+            void give(std::size_t index, Batch b)
+            {
+                Central &c = classes[index];
+                std::lock_guard<std::mutex> lock{c.mutex};
+                c.batches.push_back(b);
+            }
+
+        private:
+            struct Central {
+                std::mutex mutex;
+                std::vector<Batch> batches;
+            };
+
+            Central classes[sizeClasses];
+            std::mutex pageMutex;
+            char *regionNext = nullptr;
+            char *regionEnd = nullptr;
+
+            CentralHeap() = default;
+
+            char *pages(std::size_t bytes)
+            {
+                std::lock_guard<std::mutex> lock{pageMutex};
+                if (static_cast<std::size_t>(regionEnd - regionNext) < bytes) {
+                    std::size_t mapped = bytes < regionBytes ? regionBytes : bytes;
+                    void *p = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                    if (p == MAP_FAILED) {
+                        throw std::bad_alloc{};
+                    }
+                    regionNext = static_cast<char *>(p);
+                    regionEnd = regionNext + mapped;
+                }
+                char *result = regionNext;
+                regionNext += bytes;
+                return result;
+            }
+
+            //splits a fresh chunk into batches, keeps all but the first for other threads
+            Batch carve(std::size_t index)
+            {
+                std::size_t size = class_bytes(index), perBatch = batch_objects(index);
+                std::size_t bytes = chunkBytes < size * perBatch ? size * perBatch : chunkBytes;
+                char *chunk = pages(bytes);
+                std::size_t objects = bytes / size;
+
+                std::vector<Batch> made;
+                for (std::size_t first = 0; first < objects; first += perBatch) {
+                    std::size_t count = objects - first < perBatch ? objects - first : perBatch;
+                    FreeObject *head = reinterpret_cast<FreeObject *>(chunk + first * size);
+                    FreeObject *p = head;
+                    for (std::size_t i = 1; i < count; ++i) {
+                        p = p->next = reinterpret_cast<FreeObject *>(reinterpret_cast<char *>(p) + size);
+                    }
+                    p->next = nullptr;
+                    made.push_back(Batch{head, count});
+                }
+
+                Central &c = classes[index];
+                std::lock_guard<std::mutex> lock{c.mutex};
+                c.batches.insert(c.batches.end(), made.begin() + 1, made.end());
+                return made.front();
+            }
+        };
+
+        //per-thread free lists; frees land in the freeing thread's cache whichever thread allocated,
+        //and go back to the central lists a whole batch under one lock once the cache runs long
+        struct ThreadCache {
+            struct FreeList {
+                FreeObject *head;
+                std::size_t count;
+            };
+
+            FreeList lists[sizeClasses];
+
+            void *allocate(std::size_t index)
+            {
+                FreeList &l = lists[index];
+                if (!l.head) {
+                    Batch b = CentralHeap::get().fetch(index);
+                    l.head = b.head;
+                    l.count = b.count;
+                }
+                FreeObject *p = l.head;
+                l.head = p->next;
+                --l.count;
+                return p;
+            }
+
+            void deallocate(void *p, std::size_t index)
+            {
+                FreeList &l = lists[index];
+                FreeObject *object = static_cast<FreeObject *>(p);
+                object->next = l.head;
+                l.head = object;
+                ++l.count;
+
+                std::size_t perBatch = batch_objects(index);
+                if (l.count >= 2 * perBatch) {
+                    FreeObject *last = l.head;
+                    for (std::size_t i = 1; i < perBatch; ++i) {
+                        last = last->next;
+                    }
+                    Batch b{l.head, perBatch};
+                    l.head = last->next;
+                    l.count -= perBatch;
+                    last->next = nullptr;
+                    CentralHeap::get().give(index, b);
+                }
+            }
+
+            void flush()
+            {
+                for (std::size_t i = 0; i < sizeClasses; ++i) {
+                    if (lists[i].head) {
+                        CentralHeap::get().give(i, Batch{lists[i].head, lists[i].count});
+                        lists[i].head = nullptr;
+                        lists[i].count = 0;
+                    }
+                }
+            }
+        };
+
+        enum class CacheState : unsigned char { unborn, live, dead };
+
+        //plain thread_local data stays usable after the thread's destructors ran, so frees during
+        //thread or program exit see the dead state and go straight to the central lists
+        inline ThreadCache &thread_cache() noexcept
+        {
+            thread_local ThreadCache cache;
+            return cache;
+        }
+
+        inline CacheState &cache_state() noexcept
+        {
+            thread_local CacheState state = CacheState::unborn;
+            return state;
+        }
+
+        struct CacheReaper {
+            ~CacheReaper()
+            {
+                thread_cache().flush();
+                cache_state() = CacheState::dead;
+            }
+        };
+
+        inline ThreadCache *current_cache()
+        {
+            CacheState &state = cache_state();
+            if (state == CacheState::unborn) {
+                thread_local CacheReaper reaper;
+                static_cast<void>(reaper);
+                state = CacheState::live;
+            }
+            return state == CacheState::live ? &thread_cache() : nullptr;
+        }
+
+        inline void *cached_allocate(std::size_t bytes)
+        {
+            if (bytes > maxCachedBytes) {
+                return ::operator new(bytes);
+            }
+            std::size_t index = size_class(bytes);
+            if (ThreadCache *cache = current_cache()) {
+                return cache->allocate(index);
+            }
+            Batch b = CentralHeap::get().fetch(index);
+            if (b.count > 1) {
+                CentralHeap::get().give(index, Batch{b.head->next, b.count - 1});
+            }
+            return b.head;
+        }
+
+        inline void cached_deallocate(void *p, std::size_t bytes)
+        {
+            if (bytes > maxCachedBytes) {
+                ::operator delete(p);
+                return;
+            }
+            std::size_t index = size_class(bytes);
+            if (ThreadCache *cache = current_cache()) {
+                cache->deallocate(p, index);
+                return;
+            }
+            FreeObject *object = static_cast<FreeObject *>(p);
+            object->next = nullptr;
+            CentralHeap::get().give(index, Batch{object, 1});
+        }
+
+    } //namespace detail
+
+    //returns everything cached by the calling thread to the shared lists, e.g. before a thread
+    //that freed a lot goes idle
+    inline void thread_cache_flush()
+    {
+        if (detail::ThreadCache *cache = detail::current_cache()) {
+            cache->flush();
+        }
+    }
+
+    //stateless allocator for containers shared across threads: requests up to 32 KB are served
+    //from a per-thread cache without locking, larger ones go to operator new
+    template <typename T>
+    class ThreadCachingAllocator {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type is_always_equal;
+
+        ThreadCachingAllocator() noexcept = default;
+
+        template <typename U>
+        ThreadCachingAllocator(const ThreadCachingAllocator<U> &) noexcept
+        { }
+
+        T *allocate(size_type count);
+        void deallocate(T *p, size_type count) noexcept;
+        size_type max_size() const noexcept;
+    };
+
+    template <typename T>
+    T *ThreadCachingAllocator<T>::allocate(size_type count)
+    {
+        if (count == 0) {
+            return nullptr;
+        }
+        if (count > max_size()) {
+            throw std::bad_array_new_length{};
+        }
+        if (alignof(T) > detail::cacheAlignment) {
+            return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+        }
+        return static_cast<T *>(detail::cached_allocate(count * sizeof(T)));
+    }
+
+    template <typename T>
+    void ThreadCachingAllocator<T>::deallocate(T *p, size_type count) noexcept
+    {
+        if (!p) {
+            return;
+        }
+        if (alignof(T) > detail::cacheAlignment) {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+            return;
+        }
+        detail::cached_deallocate(p, count * sizeof(T));
+    }
+
+    template <typename T>
+    typename ThreadCachingAllocator<T>::size_type ThreadCachingAllocator<T>::max_size() const noexcept
+    { return static_cast<size_type>(-1) / sizeof(T); }
+
+    template <typename T, typename U>
+    bool operator == (const ThreadCachingAllocator<T> &, const ThreadCachingAllocator<U> &) noexcept
+    { return true; }
+
+    template <typename T, typename U>
+    bool operator != (const ThreadCachingAllocator<T> &, const ThreadCachingAllocator<U> &) noexcept
+    { return false; }
+
+} //namespace sp
+
+#endif //SP_THREAD_CACHING_ALLOCATOR__H
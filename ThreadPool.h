@@ -0,0 +1,240 @@
+//Created by sphc on 2026/10/19
+//ThreadPool.h
+//
+
+#ifndef SP_THREAD_POOL__H
+#define SP_THREAD_POOL__H
+
+#include <atomic> //atomic
+#include <condition_variable> //condition_variable
+#include <cstddef> //size_t
+#include <deque> //deque
+#include <exception> //exception_ptr, current_exception, rethrow_exception
+#include <functional> //function
+#include <memory> //unique_ptr, shared_ptr, make_shared
+#include <mutex> //mutex, lock_guard, unique_lock
+#include <thread> //thread, hardware_concurrency
+#include <utility> //move
+#include <vector> //vector
+
+namespace sp {
+
+    //work-stealing executor: every worker owns a deque, runs its own tasks newest first and steals
+    //the oldest task of another worker when it runs dry. A thread waiting in parallel_for runs
+    //tasks too, so parallel_for may be nested.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threads = default_threads());
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator = (const ThreadPool &) = delete;
+        ~ThreadPool();
+
+        std::size_t size() const noexcept
+        { return queues.size(); }
+
+        //fire and forget; the task must not throw
+        void submit(std::function<void()> task);
+
+        //calls body(i) for every i in [first, last) and returns once all calls did. Consecutive
+        //indices are grouped into one task per worker and a little more, handed out round robin,
+        //so index ranges keep a stable owner unless somebody steals. The first exception thrown
+        //by body is rethrown here after the remaining calls finished.
+        template <typename Body>
+        void parallel_for(std::size_t first, std::size_t last, Body body);
+
+        //shared pool sized to the machine, started on first use
+        static ThreadPool &global();
+
+        static std::size_t default_threads() noexcept
+        {
+            unsigned n = std::thread::hardware_concurrency();
+            return n ? n : 1;
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> queued;
+        std::atomic<std::size_t> nextQueue;
+        std::mutex sleepMutex;
+        std::condition_variable wakeup;
+        bool stopping;
+
+        void push(std::size_t queue, std::function<void()> task);
+        bool run_one(std::size_t self);
+        void work(std::size_t self);
+
+        //index of the calling thread's queue in this pool, or size() for outside threads
+        std::size_t self_index() const noexcept;
+
+        static const ThreadPool *&current_pool() noexcept
+        {
+            thread_local const ThreadPool *pool = nullptr;
+            return pool;
+        }
+
+        static std::size_t &current_index() noexcept
+        {
+            thread_local std::size_t index = 0;
+            return index;
+        }
+    };
+
+    inline ThreadPool::ThreadPool(std::size_t threads)
+        : queued{0}, nextQueue{0}, stopping{false}
+    {
+        threads = threads ? threads : 1;
+        for (std::size_t i = 0; i < threads; ++i) {
+            queues.emplace_back(new Queue);
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    inline ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{sleepMutex};
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread &w : workers) {
+            w.join();
+        }
+    }
+
+    inline void ThreadPool::submit(std::function<void()> task)
+    {
+        std::size_t self = self_index();
+        push(self < size() ? self : nextQueue.fetch_add(1, std::memory_order_relaxed) % size(), std::move(task));
+    }
+
+    template <typename Body>
+    void ThreadPool::parallel_for(std::size_t first, std::size_t last, Body body)
+    {
+        if (first >= last) {
+            return;
+        }
+
+        struct Group {
+            std::atomic<std::size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+        };
+
+        std::size_t count = last - first;
+        std::size_t tasks = count < size() + 1 ? count : size() + 1;
+        std::size_t step = (count + tasks - 1) / tasks;
+        tasks = (count + step - 1) / step;
+
+        std::shared_ptr<Group> group = std::make_shared<Group>();
+        group->remaining.store(tasks, std::memory_order_relaxed);
+
+        std::size_t start = nextQueue.fetch_add(tasks, std::memory_order_relaxed);
+        for (std::size_t t = 0; t < tasks; ++t) {
+            std::size_t lo = first + t * step, hi = lo + step < last ? lo + step : last;
+            push((start + t) % size(), [group, &body, lo, hi] {
+                try {
+                    for (std::size_t i = lo; i < hi; ++i) {
+                        body(i);
+                    }
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock{group->mutex};
+                    if (!group->error) {
+                        group->error = std::current_exception();
+                    }
+                }
+                if (group->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock{group->mutex};
+                    group->done.notify_all();
+                }
+            });
+        }
+
+        std::size_t self = self_index();
+        while (group->remaining.load(std::memory_order_acquire)) {
+            if (!run_one(self)) {
+                std::unique_lock<std::mutex> lock{group->mutex};
+                group->done.wait(lock, [&group] { return group->remaining.load(std::memory_order_acquire) == 0; });
+            }
+        }
+        if (group->error) {
+            std::rethrow_exception(group->error);
+        }
+    }
+
+    inline ThreadPool &ThreadPool::global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    inline void ThreadPool::push(std::size_t queue, std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock{queues[queue]->mutex};
+            queues[queue]->tasks.push_back(std::move(task));
+        }
+        queued.fetch_add(1, std::memory_order_release);
+        //taking the lock orders this with a worker that just found nothing and is about to sleep
+        { std::lock_guard<std::mutex> lock{sleepMutex}; }
+        wakeup.notify_one();
+    }
+
+    inline bool ThreadPool::run_one(std::size_t self)
+    {
+        std::function<void()> task;
+        for (std::size_t k = 0; k < size() && !task; ++k) {
+            std::size_t victim = self < size() ? (self + k) % size() : k;
+            Queue &q = *queues[victim];
+            std::lock_guard<std::mutex> lock{q.mutex};
+            if (q.tasks.empty()) {
+                continue;
+            }
+            if (victim == self) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+            else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+        }
+        if (!task) {
+            return false;
+        }
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    inline void ThreadPool::work(std::size_t self)
+    {
+        current_pool() = this;
+        current_index() = self;
+        for (;;) {
+            if (run_one(self)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock{sleepMutex};
+            wakeup.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+            if (stopping && queued.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    inline std::size_t ThreadPool::self_index() const noexcept
+    { return current_pool() == this ? current_index() : size(); }
+
+} //namespace sp
+
+#endif //SP_THREAD_POOL__H
@@ -7,9 +7,20 @@
 
 #include <cstddef> //size_t, ptrdiff_t
 #include <climits> //UINT_MAX
-#include <memory> //allocator, uninitialized_copy, uninitialized_fill_n
+#include <memory> //allocator, uninitialized_copy, uninitialized_fill_n, unique_ptr
 #include <initializer_list> //initializer_list
 #include <iterator> //distance
+#include <cerrno> //errno, EINTR
+#include <cstring> //memcpy
+#include <istream> //istream
+#include <stdexcept> //runtime_error
+#include <system_error> //system_error
+#include <type_traits> //is_trivially_copyable
+#include <fcntl.h> //posix_fadvise
+#include <sys/stat.h> //fstat
+#include <sys/uio.h> //readv
+#include <unistd.h> //read, lseek
+#include "Instrument.h"
 
 namespace sp {
 
@@ -73,7 +84,7 @@ namespace sp {
             bool operator != (const_reverse_iterator other)
             { return !(*this == other); }
 
-        private:
+        protected:
             value_type *data;
         };
 
@@ -85,38 +96,38 @@ namespace sp {
 
             reverse_iterator &operator ++ ()
             {
-                --data; 
+                --this->data; 
                 return *this;
             }
 
             reverse_iterator operator ++ (int)
             {
                 reverse_iterator tmp = *this;
-                --data;
+                --this->data;
                 return tmp;
             }
 
             reverse_iterator &operator -- ()
             {
-                ++data;
+                ++this->data;
                 return *this;
             }
 
             reverse_iterator operator -- (int)
             {
                 reverse_iterator tmp = *this;
-                ++data;
+                ++this->data;
                 return tmp;
             }
 
             reverse_iterator operator + (int step) const
-            { return reverse_iterator{data - step}; }
+            { return reverse_iterator{this->data - step}; }
 
             reverse_iterator operator - (int step) const
-            { return reverse_iterator{data + step}; }
+            { return reverse_iterator{this->data + step}; }
 
             reference operator * () const
-            { return *data; }
+            { return *this->data; }
         };
 
 
@@ -198,16 +209,42 @@ namespace sp {
         void resize(size_type count, const value_type &value);
         void swap(Vector &other);
 
+        //bulk input, trivially copyable T only: bytes land directly in the uninitialized tail
+        size_type append_from_fd(int fd, size_type maxBytes = static_cast<size_type>(-1), bool sequential = false);
+        size_type append_from(std::istream &in, size_type maxBytes = static_cast<size_type>(-1));
+        void read_exact(int fd, size_type count);
+        void read_exact(std::istream &in, size_type count);
+
+        //parallel first-touch construction: the new elements are split in chunks built by the
+        //executor's workers, so each page is first written, and placed, by the thread that fills
+        //it. Executor needs parallel_for(first, last, body(index)), e.g. sp::ThreadPool.
+        template <typename Executor>
+        void parallel_assign(Executor &executor, size_type count, const value_type &value);
+        template <typename Executor>
+        void parallel_assign(Executor &executor, const Vector &other);
+        template <typename Executor, typename Generator>
+        void parallel_generate(Executor &executor, size_type count, Generator gen);
+        template <typename Executor>
+        void parallel_resize(Executor &executor, size_type count, const value_type &value);
+
     private:
         value_type *start; //start of memory
         value_type *finish; //next position of last element
         value_type *termination; //next position of last memory
         allocator_type alloc;
 
+        typedef instrument::detail::Probe<Vector> probe;
+        typedef instrument::detail::Timer<Vector> timer;
+
         template <typename InputIterator>
         void alloc_copy(InputIterator first, InputIterator last);
         void alloc_copy(size_type count, const value_type &value);
         void reallocate(size_type theCapacity);
+        char *grow_bytes(size_type usedBytes, size_type extraBytes);
+        template <typename Executor, typename Construct>
+        void parallel_construct(Executor &executor, value_type *data, size_type first, size_type last, Construct construct);
+        template <typename Executor, typename Construct>
+        void parallel_rebuild(Executor &executor, size_type count, Construct construct);
         void free();
     };
 
@@ -272,6 +309,7 @@ namespace sp {
             free();
             alloc_copy(other.begin(), other.end());
         }
+        return *this;
     }
 
     template <typename T, typename Allocator>
@@ -284,6 +322,7 @@ namespace sp {
             termination = other.termination;
             other.start = other.finish = other.termination = nullptr; 
         }
+        return *this;
     }
 
     template <typename T, typename Allocator>
@@ -430,30 +469,35 @@ namespace sp {
     template <typename T, typename Allocator>
     void Vector<T, Allocator>::push_back(const value_type &value)
     {
+        timer timed{instrument::Op::pushBack};
         if (finish >= termination) {
             reallocate(capacity() ? 2 * capacity() : 1);
         }
 
-        alloc.construct(finish++, value);
+        std::allocator_traits<allocator_type>::construct(alloc, finish++, value);
+        probe::copy(1);
     }
 
     template <typename T, typename Allocator>
     void Vector<T, Allocator>::push_back(value_type &&value)
     {
+        timer timed{instrument::Op::pushBack};
         if (finish >= termination) {
             reallocate(capacity() ? 2 * capacity() : 1);
         }
 
-        alloc.construct(finish++, std::move(value));
+        std::allocator_traits<allocator_type>::construct(alloc, finish++, std::move(value));
+        probe::move(1);
     }
 
     template <typename T, typename Allocator>
     void Vector<T, Allocator>::pop_back()
-    { alloc.destroy(--finish); }
+    { std::allocator_traits<allocator_type>::destroy(alloc, --finish); }
 
     template <typename T, typename Allocator>
     typename Vector<T, Allocator>::iterator Vector<T, Allocator>::insert(const_iterator pos, const value_type &value)
     {
+        timer timed{instrument::Op::insert};
         difference_type diff = pos - start;
         push_back(value_type{});
         pos = start + diff;
@@ -463,6 +507,7 @@ namespace sp {
             --it;
         }
         *it = value;
+        probe::copy(size() - diff);
 
         return it;
     }
@@ -470,6 +515,7 @@ namespace sp {
     template <typename T, typename Allocator>
     typename Vector<T, Allocator>::iterator Vector<T, Allocator>::insert(const_iterator pos, value_type &&value)
     {
+        timer timed{instrument::Op::insert};
         difference_type diff = std::distance(cbegin(), pos);
         push_back(value_type{});
         pos = start + diff;
@@ -479,6 +525,8 @@ namespace sp {
             --it;
         }
         *it = std::move(value);
+        probe::copy(size() - diff - 1);
+        probe::move(1);
 
         return it;
     }
@@ -486,9 +534,11 @@ namespace sp {
     template <typename T, typename Allocator>
     typename Vector<T, Allocator>::iterator Vector<T, Allocator>::insert(const_iterator pos, size_type count, const value_type &value)
     {
+        timer timed{instrument::Op::insert};
         difference_type diff = std::distance(cbegin(), pos);
+        probe::copy(size() - diff + count);
 
-        for (difference_type i = 0; i < count; ++i) {
+        for (size_type i = 0; i < count; ++i) {
             push_back(value_type{});
         }
         iterator it = end() - 1;
@@ -507,8 +557,10 @@ namespace sp {
     template<typename InputIterator>
     typename Vector<T, Allocator>::iterator Vector<T, Allocator>::insert(const_iterator pos, InputIterator first, InputIterator last)
     {
+        timer timed{instrument::Op::insert};
         difference_type count = std::distance(first, last);
         difference_type diff = std::distance(cbegin(), pos);
+        probe::copy(size() - diff + count);
 
         for (difference_type i = 0; i < count; ++i) {
             push_back(value_type{});
@@ -533,6 +585,7 @@ namespace sp {
     typename Vector<T, Allocator>::iterator Vector<T, Allocator>::erase(const_iterator pos)
     {
         iterator it = const_cast<iterator>(pos), result = it;
+        probe::copy(end() - it - 1);
 
         while (it + 1 != end()) {
             *it = *(it + 1);
@@ -548,6 +601,7 @@ namespace sp {
     {
         difference_type count = std::distance(first, last);
         iterator it = const_cast<iterator>(first), result = it;
+        probe::copy(end() - it - count);
 
         while (it + count != end()) {
             *it = *(it + count);
@@ -571,6 +625,7 @@ namespace sp {
             reallocate(count);
         }
         if (count > size()) {
+            probe::copy(count - size());
             finish = std::uninitialized_fill_n(finish, count - size(), value);
         }
         while (size() > count) {
@@ -591,6 +646,289 @@ namespace sp {
         std::swap(alloc, other.alloc);
     }
 
+    template <typename T, typename Allocator>
+    typename Vector<T, Allocator>::size_type Vector<T, Allocator>::append_from_fd(int fd, size_type maxBytes, bool sequential)
+    {
+        static_assert(std::is_trivially_copyable<value_type>::value, "append_from_fd requires a trivially copyable type");
+
+        size_type oldSize = size();
+        size_type limit = maxBytes - maxBytes % sizeof(value_type);
+
+        //a regular file tells us how much is left, so size the buffer once
+        struct stat st;
+        off_t at;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && (at = ::lseek(fd, 0, SEEK_CUR)) >= 0 && st.st_size > at) {
+            size_type left = static_cast<size_type>(st.st_size - at);
+            left = left < limit ? left : limit;
+            reserve(size() + left / sizeof(value_type));
+            if (sequential) {
+                ::posix_fadvise(fd, at, static_cast<off_t>(left), POSIX_FADV_SEQUENTIAL);
+                ::posix_fadvise(fd, at, static_cast<off_t>(left), POSIX_FADV_WILLNEED);
+            }
+        }
+
+        //whatever does not fit in the tail spills to the stack, so reaching end of file never
+        //costs a speculative regrowth
+        char spill[16384];
+        char *raw = reinterpret_cast<char *>(finish);
+        size_type done = 0;
+        while (done < limit) {
+            size_type room = static_cast<size_type>(reinterpret_cast<char *>(termination) - raw);
+            iovec iov[2];
+            iov[0].iov_base = raw;
+            iov[0].iov_len = room < limit - done ? room : limit - done;
+            iov[1].iov_base = spill;
+            iov[1].iov_len = sizeof(spill) < limit - done - iov[0].iov_len ? sizeof(spill) : limit - done - iov[0].iov_len;
+
+            ssize_t n = ::readv(fd, iov, 2);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                int err = errno;
+                finish = start + oldSize;
+                throw std::system_error{err, std::generic_category(), "sp::Vector::append_from_fd: readv"};
+            }
+            if (n == 0) {
+                break;
+            }
+
+            size_type got = static_cast<size_type>(n);
+            size_type inTail = got < iov[0].iov_len ? got : iov[0].iov_len;
+            done += got;
+            raw += inTail;
+            if (got > inTail) {
+                raw = grow_bytes(static_cast<size_type>(raw - reinterpret_cast<char *>(start)), got - inTail);
+                std::memcpy(raw, spill, got - inTail);
+                raw += got - inTail;
+            }
+        }
+
+        if ((raw - reinterpret_cast<char *>(start)) % sizeof(value_type)) {
+            finish = start + oldSize;
+            throw std::runtime_error{"sp::Vector::append_from_fd: input ends inside an element"};
+        }
+        finish = reinterpret_cast<value_type *>(raw);
+
+        return size() - oldSize;
+    }
+
+    template <typename T, typename Allocator>
+    typename Vector<T, Allocator>::size_type Vector<T, Allocator>::append_from(std::istream &in, size_type maxBytes)
+    {
+        static_assert(std::is_trivially_copyable<value_type>::value, "append_from requires a trivially copyable type");
+
+        typedef std::istream::traits_type traits_type;
+        std::streambuf *buf = in.rdbuf();
+        size_type oldSize = size();
+        size_type limit = maxBytes - maxBytes % sizeof(value_type);
+        char *raw = reinterpret_cast<char *>(finish);
+        size_type done = 0;
+
+        while (done < limit) {
+            size_type room = static_cast<size_type>(reinterpret_cast<char *>(termination) - raw);
+            if (room == 0) {
+                //only grow once we know more input is coming
+                if (traits_type::eq_int_type(buf->sgetc(), traits_type::eof())) {
+                    break;
+                }
+                raw = grow_bytes(static_cast<size_type>(raw - reinterpret_cast<char *>(start)), 1);
+                continue;
+            }
+            size_type want = room < limit - done ? room : limit - done;
+            size_type got = static_cast<size_type>(buf->sgetn(raw, static_cast<std::streamsize>(want)));
+            raw += got;
+            done += got;
+            if (got < want) {
+                break;
+            }
+        }
+
+        if (done < limit) {
+            in.setstate(std::ios::eofbit);
+        }
+        if ((raw - reinterpret_cast<char *>(start)) % sizeof(value_type)) {
+            finish = start + oldSize;
+            in.setstate(std::ios::failbit);
+            throw std::runtime_error{"sp::Vector::append_from: input ends inside an element"};
+        }
+        finish = reinterpret_cast<value_type *>(raw);
+
+        return size() - oldSize;
+    }
+
+    template <typename T, typename Allocator>
+    void Vector<T, Allocator>::read_exact(int fd, size_type count)
+    {
+        static_assert(std::is_trivially_copyable<value_type>::value, "read_exact requires a trivially copyable type");
+
+        reserve(size() + count);
+        char *raw = reinterpret_cast<char *>(finish);
+        size_type left = count * sizeof(value_type);
+        while (left) {
+            ssize_t n = ::read(fd, raw, left);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error{errno, std::generic_category(), "sp::Vector::read_exact: read"};
+            }
+            if (n == 0) {
+                throw std::runtime_error{"sp::Vector::read_exact: unexpected end of file"};
+            }
+            raw += n;
+            left -= static_cast<size_type>(n);
+        }
+        finish += count;
+    }
+
+    template <typename T, typename Allocator>
+    void Vector<T, Allocator>::read_exact(std::istream &in, size_type count)
+    {
+        static_assert(std::is_trivially_copyable<value_type>::value, "read_exact requires a trivially copyable type");
+
+        reserve(size() + count);
+        if (!in.read(reinterpret_cast<char *>(finish), static_cast<std::streamsize>(count * sizeof(value_type)))) {
+            throw std::runtime_error{"sp::Vector::read_exact: unexpected end of stream"};
+        }
+        finish += count;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename Executor>
+    void Vector<T, Allocator>::parallel_assign(Executor &executor, size_type count, const value_type &value)
+    {
+        parallel_rebuild(executor, count, [this, &value](value_type *p, size_type) {
+            std::allocator_traits<allocator_type>::construct(alloc, p, value);
+        });
+    }
+
+    template <typename T, typename Allocator>
+    template <typename Executor>
+    void Vector<T, Allocator>::parallel_assign(Executor &executor, const Vector &other)
+    {
+        if (this != &other) {
+            const value_type *source = other.start;
+            parallel_rebuild(executor, other.size(), [this, source](value_type *p, size_type i) {
+                std::allocator_traits<allocator_type>::construct(alloc, p, source[i]);
+            });
+        }
+    }
+
+    //gen(i) makes element i; it is called concurrently and in no particular order
+    template <typename T, typename Allocator>
+    template <typename Executor, typename Generator>
+    void Vector<T, Allocator>::parallel_generate(Executor &executor, size_type count, Generator gen)
+    {
+        parallel_rebuild(executor, count, [this, &gen](value_type *p, size_type i) {
+            std::allocator_traits<allocator_type>::construct(alloc, p, gen(i));
+        });
+    }
+
+    template <typename T, typename Allocator>
+    template <typename Executor>
+    void Vector<T, Allocator>::parallel_resize(Executor &executor, size_type count, const value_type &value)
+    {
+        if (count <= size()) {
+            resize(count, value);
+            return;
+        }
+        if (count <= capacity()) {
+            parallel_construct(executor, start, size(), count, [this, &value](value_type *p, size_type) {
+                std::allocator_traits<allocator_type>::construct(alloc, p, value);
+            });
+            probe::copy(count - size());
+            finish = start + count;
+            return;
+        }
+        //growing moves the old elements too, so they also end up next to their writer
+        const value_type *old = start;
+        size_type oldSize = size();
+        probe::reallocate();
+        parallel_rebuild(executor, count, [this, old, oldSize, &value](value_type *p, size_type i) {
+            std::allocator_traits<allocator_type>::construct(alloc, p, i < oldSize ? old[i] : value);
+        });
+    }
+
+    //constructs data[first, last) with construct(pointer, index) in chunks of about 2 MB; if any
+    //element throws, every element built so far is destroyed and the exception is rethrown
+    template <typename T, typename Allocator>
+    template <typename Executor, typename Construct>
+    void Vector<T, Allocator>::parallel_construct(Executor &executor, value_type *data, size_type first, size_type last, Construct construct)
+    {
+        const size_type chunk = sizeof(value_type) < (size_type{1} << 21) ? (size_type{1} << 21) / sizeof(value_type) : 1;
+        const size_type chunks = (last - first + chunk - 1) / chunk;
+        if (chunks == 0) {
+            return;
+        }
+
+        auto build = [this, data, first, last, chunk, &construct](size_type c) {
+            value_type *lo = data + first + c * chunk;
+            value_type *hi = data + (last - first - c * chunk < chunk ? last : first + (c + 1) * chunk);
+            value_type *p = lo;
+            try {
+                for (; p != hi; ++p) {
+                    construct(p, static_cast<size_type>(p - data));
+                }
+            }
+            catch (...) {
+                while (p != lo) {
+                    std::allocator_traits<allocator_type>::destroy(alloc, --p);
+                }
+                throw;
+            }
+        };
+
+        if (chunks == 1) {
+            build(0);
+            return;
+        }
+
+        std::unique_ptr<unsigned char[]> built{new unsigned char[chunks]()};
+        try {
+            executor.parallel_for(0, chunks, [&build, &built](size_type c) {
+                build(c);
+                built[c] = 1;
+            });
+        }
+        catch (...) {
+            for (size_type c = 0; c < chunks; ++c) {
+                if (built[c]) {
+                    value_type *lo = data + first + c * chunk;
+                    value_type *hi = data + (last - first - c * chunk < chunk ? last : first + (c + 1) * chunk);
+                    while (hi != lo) {
+                        std::allocator_traits<allocator_type>::destroy(alloc, --hi);
+                    }
+                }
+            }
+            throw;
+        }
+    }
+
+    //replaces the contents with count elements built into a fresh, untouched buffer
+    template <typename T, typename Allocator>
+    template <typename Executor, typename Construct>
+    void Vector<T, Allocator>::parallel_rebuild(Executor &executor, size_type count, Construct construct)
+    {
+        value_type *newData = count ? alloc.allocate(count) : nullptr;
+        try {
+            parallel_construct(executor, newData, 0, count, construct);
+        }
+        catch (...) {
+            alloc.deallocate(newData, count);
+            throw;
+        }
+        if (newData) {
+            probe::allocate(count * sizeof(value_type));
+            probe::copy(count);
+            probe::capacity(count);
+        }
+        free();
+        start = newData;
+        finish = start + count;
+        termination = start + count;
+    }
+
     template <typename T, typename Allocator>
     template <typename InputIterator>
     void Vector<T, Allocator>::alloc_copy(InputIterator first, InputIterator last)
@@ -598,6 +936,9 @@ namespace sp {
         finish = start = alloc.allocate(static_cast<size_type>(last - first));
         termination = start + (last - first);
         finish = std::uninitialized_copy(first, last, start);
+        probe::allocate(capacity() * sizeof(value_type));
+        probe::copy(size());
+        probe::capacity(capacity());
     }
     
     template <typename T, typename Allocator>
@@ -606,6 +947,9 @@ namespace sp {
         start = alloc.allocate(count);
         termination = start + count;
         finish = std::uninitialized_fill_n(start, count, value);
+        probe::allocate(count * sizeof(value_type));
+        probe::copy(count);
+        probe::capacity(count);
     }
 
     template <typename T, typename Allocator>
@@ -613,17 +957,49 @@ namespace sp {
     {
         value_type *newData = alloc.allocate(theCapacity);
         value_type *tmp = std::uninitialized_copy(begin(), end(), newData);
-        termination = newData + theCapacity;
+        probe::reallocate();
+        probe::allocate(theCapacity * sizeof(value_type));
+        probe::copy(size());
+        probe::capacity(theCapacity);
         free();
         start = newData;
         finish = tmp;
+        termination = newData + theCapacity;
+    }
+
+    //geometric growth for the bulk readers; usedBytes may end inside an element, those bytes are
+    //carried over too. Returns the new position of byte usedBytes.
+    template <typename T, typename Allocator>
+    char *Vector<T, Allocator>::grow_bytes(size_type usedBytes, size_type extraBytes)
+    {
+        size_type needed = (usedBytes + extraBytes + sizeof(value_type) - 1) / sizeof(value_type);
+        size_type newCapacity = capacity() ? 2 * capacity() : 4096 / sizeof(value_type) + 1;
+        newCapacity = newCapacity < needed ? needed : newCapacity;
+
+        value_type *newData = alloc.allocate(newCapacity);
+        if (usedBytes) {
+            std::memcpy(newData, start, usedBytes);
+        }
+        probe::reallocate();
+        probe::allocate(newCapacity * sizeof(value_type));
+        probe::copy(usedBytes / sizeof(value_type));
+        probe::capacity(newCapacity);
+        free();
+        start = newData;
+        finish = start + usedBytes / sizeof(value_type);
+        termination = start + newCapacity;
+
+        return reinterpret_cast<char *>(start) + usedBytes;
     }
 
     template <typename T, typename Allocator>
     void Vector<T, Allocator>::free()
     {
         while (finish != start) {
-            alloc.destroy(--finish);
+            std::allocator_traits<allocator_type>::destroy(alloc, --finish);
+        }
+        if (start) {
+            probe::deallocate(capacity() * sizeof(value_type));
         }
         alloc.deallocate(start, capacity());
     }
@@ -0,0 +1,80 @@
+#include "../Vector.h"
+#include "../List.h"
+#include "../ThreadCachingAllocator.h"
+#include "benchUtil.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace sp_bench;
+
+//each thread frees what its neighbour allocated, the pattern that makes malloc's arenas contend
+template <typename Container>
+void handOff(size_t threads, size_t perThread)
+{
+    vector<vector<Container *>> made(threads);
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&made, t, perThread] {
+            made[t].reserve(perThread);
+            for (size_t i = 0; i < perThread; ++i) {
+                Container *c = new Container;
+                for (size_t k = 0; k < 1 + i % 16; ++k) {
+                    c->push_back(static_cast<typename Container::value_type>(k));
+                }
+                made[t].push_back(c);
+            }
+        });
+    }
+    for (thread &w : workers) {
+        w.join();
+    }
+    workers.clear();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&made, t, threads] {
+            for (Container *c : made[(t + 1) % threads]) {
+                delete c;
+            }
+        });
+    }
+    for (thread &w : workers) {
+        w.join();
+    }
+}
+
+template <template <typename> class Alloc>
+void all(Runner &runner, const string &allocator)
+{
+    const size_t perThread = 20000;
+    for (size_t threads : {1u, 4u, 16u}) {
+        runner.run("handoff", "sp::Vector<" + allocator + ">", "uint64", threads, threads * perThread,
+            [] { return 0; },
+            [threads](int &) { handOff<sp::Vector<uint64_t, Alloc<uint64_t>>>(threads, perThread); });
+        runner.run("handoff", "sp::List<" + allocator + ">", "uint64", threads, threads * perThread,
+            [] { return 0; },
+            [threads](int &) { handOff<sp::List<uint64_t, Alloc<uint64_t>>>(threads, perThread); });
+    }
+
+    runner.run("push_pop", "sp::List<" + allocator + ">", "uint64", 100000, 100000,
+        [] { return sp::List<uint64_t, Alloc<uint64_t>>{}; },
+        [](sp::List<uint64_t, Alloc<uint64_t>> &l) {
+            for (uint64_t i = 0; i < 100000; ++i) {
+                l.push_back(i);
+            }
+            while (!l.empty()) {
+                l.pop_front();
+            }
+        });
+}
+
+int main(int argc, char **argv)
+{
+    Runner runner{argc, argv};
+
+    all<std::allocator>(runner, "std::allocator");
+    all<sp::ThreadCachingAllocator>(runner, "ThreadCachingAllocator");
+
+    return runner.finish();
+}
@@ -0,0 +1,212 @@
+#include "../Vector.h"
+#include "../List.h"
+#include "../Sort.h"
+#include "benchUtil.h"
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace sp_bench;
+
+struct Blob64 {
+    uint64_t key;
+    char payload[56];
+
+    bool operator < (const Blob64 &other) const
+    { return key < other.key; }
+};
+
+template <typename T>
+T make(size_t i);
+
+template <>
+int make<int>(size_t i)
+{ return static_cast<int>((i * 2654435761u) & 0x7fffffff); }
+
+template <>
+uint64_t make<uint64_t>(size_t i)
+{ return i * 0x9E3779B97F4A7C15ULL; }
+
+template <>
+string make<string>(size_t i)
+{ return "key-" + to_string(i * 2654435761u) + "-padding-past-sso"; }
+
+template <>
+Blob64 make<Blob64>(size_t i)
+{
+    Blob64 b{};
+    b.key = make<uint64_t>(i);
+    return b;
+}
+
+template <typename T> const char *typeName();
+template <> const char *typeName<int>() { return "int"; }
+template <> const char *typeName<uint64_t>() { return "uint64"; }
+template <> const char *typeName<string>() { return "string"; }
+template <> const char *typeName<Blob64>() { return "blob64"; }
+
+template <typename C>
+C filled(size_t n)
+{
+    C c;
+    for (size_t i = 0; i < n; ++i) {
+        c.push_back(make<typename C::value_type>(i));
+    }
+    return c;
+}
+
+template <typename C>
+void sortContainer(C &c);
+
+template <typename T>
+void sortContainer(sp::Vector<T> &c)
+{ sp::sort(c); }
+
+template <typename T>
+void sortContainer(vector<T> &c)
+{ std::sort(c.begin(), c.end()); }
+
+template <typename T>
+void sortContainer(sp::List<T> &c)
+{ c.sort(); }
+
+template <typename T>
+void sortContainer(list<T> &c)
+{ c.sort(); }
+
+//ops shared by every container
+template <typename C>
+void common(Runner &runner, const string &name, size_t n)
+{
+    typedef typename C::value_type T;
+    const string type = typeName<T>();
+
+    runner.run("push_back", name, type, n, n,
+        [] { return C{}; },
+        [n](C &c) {
+            for (size_t i = 0; i < n; ++i) {
+                c.push_back(make<T>(i));
+            }
+        });
+
+    runner.run("iterate", name, type, n, n,
+        [n] { return filled<C>(n); },
+        [](C &c) {
+            size_t touched = 0;
+            for (const T &x : c) {
+                doNotOptimize(x);
+                ++touched;
+            }
+            doNotOptimize(touched);
+        });
+
+    runner.run("sort", name, type, n, n,
+        [n] { return filled<C>(n); },
+        [](C &c) { sortContainer(c); });
+
+    runner.run("copy", name, type, n, n,
+        [n] { return make_pair(filled<C>(n), C{}); },
+        [](pair<C, C> &p) {
+            C copy(p.first);
+            p.second.swap(copy);
+        });
+
+    runner.run("move", name, type, n, 1,
+        [n] { return make_pair(filled<C>(n), C{}); },
+        [](pair<C, C> &p) {
+            C moved(std::move(p.first));
+            p.second.swap(moved);
+        });
+}
+
+//insert and erase at the middle; quadratic for vectors, so run at smaller sizes
+template <typename C>
+void vectorEdits(Runner &runner, const string &name, size_t n)
+{
+    typedef typename C::value_type T;
+    const string type = typeName<T>();
+
+    runner.run("insert_middle", name, type, n, n,
+        [] { return C{}; },
+        [n](C &c) {
+            for (size_t i = 0; i < n; ++i) {
+                c.insert(c.begin() + c.size() / 2, make<T>(i));
+            }
+        });
+
+    runner.run("erase_middle", name, type, n, n,
+        [n] { return filled<C>(n); },
+        [](C &c) {
+            while (!c.empty()) {
+                c.erase(c.begin() + c.size() / 2);
+            }
+        });
+}
+
+template <typename C>
+void listEdits(Runner &runner, const string &name, size_t n)
+{
+    typedef typename C::value_type T;
+    const string type = typeName<T>();
+
+    runner.run("insert_middle", name, type, n, n,
+        [] { return C{}; },
+        [n](C &c) {
+            c.push_back(make<T>(0));
+            auto mid = c.begin();
+            for (size_t i = 1; i < n; ++i) {
+                mid = c.insert(mid, make<T>(i));
+                if (i % 2) {
+                    ++mid;
+                }
+            }
+        });
+
+    runner.run("erase_middle", name, type, n, n,
+        [n] { return filled<C>(n); },
+        [n](C &c) {
+            auto mid = c.begin();
+            for (size_t i = 0; i < n / 2; ++i) {
+                ++mid;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                mid = c.erase(mid);
+                if (mid == c.end() && !c.empty()) {
+                    --mid;
+                }
+            }
+        });
+}
+
+template <typename T>
+void all(Runner &runner)
+{
+    for (size_t n : {1000u, 100000u}) {
+        common<sp::Vector<T>>(runner, "sp::Vector", n);
+        common<vector<T>>(runner, "std::vector", n);
+        common<sp::List<T>>(runner, "sp::List", n);
+        common<list<T>>(runner, "std::list", n);
+    }
+    for (size_t n : {1000u, 10000u}) {
+        vectorEdits<sp::Vector<T>>(runner, "sp::Vector", n);
+        vectorEdits<vector<T>>(runner, "std::vector", n);
+        listEdits<sp::List<T>>(runner, "sp::List", n);
+        listEdits<list<T>>(runner, "std::list", n);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Runner runner{argc, argv};
+
+    all<int>(runner);
+    all<uint64_t>(runner);
+    all<string>(runner);
+    all<Blob64>(runner);
+
+    return runner.finish();
+}
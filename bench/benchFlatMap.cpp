@@ -0,0 +1,72 @@
+#include "../FlatMap.h"
+#include "benchUtil.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace sp_bench;
+
+template <sp::FlatSearch Search>
+using Table = sp::FlatMap<uint64_t, uint64_t, less<uint64_t>, allocator<pair<const uint64_t, uint64_t>>, Search>;
+
+static vector<pair<uint64_t, uint64_t>> entries(size_t n)
+{
+    mt19937_64 gen{42};
+    vector<pair<uint64_t, uint64_t>> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = {gen(), i};
+    }
+    return v;
+}
+
+template <typename Map>
+static void lookup(Runner &runner, const string &container, const vector<pair<uint64_t, uint64_t>> &input,
+                   const vector<uint64_t> &queries)
+{
+    Map map(input.begin(), input.end());
+    runner.run("find", container, "u64->u64", input.size(), queries.size(),
+        [] { return uint64_t{0}; },
+        [&map, &queries](uint64_t &sum) {
+            for (uint64_t q : queries) {
+                auto it = map.find(q);
+                sum += it != map.end() ? (*it).second : 1;
+            }
+        });
+}
+
+template <typename Map>
+static void build(Runner &runner, const string &container, const vector<pair<uint64_t, uint64_t>> &input)
+{
+    runner.run("build", container, "u64->u64", input.size(), input.size(),
+        [] { return Map{}; },
+        [&input](Map &map) { map.insert(input.begin(), input.end()); });
+}
+
+//read-mostly table: bulk build once, then random hits and misses
+int main(int argc, char **argv)
+{
+    Runner runner{argc, argv};
+
+    for (size_t n : {size_t{1} << 10, size_t{1} << 20}) {
+        vector<pair<uint64_t, uint64_t>> input = entries(n);
+        mt19937_64 gen{7};
+        vector<uint64_t> queries(1 << 16);
+        for (uint64_t &q : queries) {
+            q = gen() % 2 ? input[gen() % n].first : gen();
+        }
+
+        build<map<uint64_t, uint64_t>>(runner, "std::map", input);
+        build<Table<sp::FlatSearch::branchless>>(runner, "sp::FlatMap", input);
+
+        lookup<map<uint64_t, uint64_t>>(runner, "std::map", input, queries);
+        lookup<Table<sp::FlatSearch::binary>>(runner, "sp::FlatMap<binary>", input, queries);
+        lookup<Table<sp::FlatSearch::branchless>>(runner, "sp::FlatMap<branchless>", input, queries);
+        lookup<Table<sp::FlatSearch::eytzinger>>(runner, "sp::FlatMap<eytzinger>", input, queries);
+    }
+
+    return runner.finish();
+}
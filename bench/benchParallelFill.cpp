@@ -0,0 +1,47 @@
+#include "../Vector.h"
+#include "../ThreadPool.h"
+#include "benchUtil.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace sp_bench;
+
+//fresh pages every iteration, so each run pays the page faults the parallel fill spreads out;
+//compare the threads=N rows against serial for the wall-clock speedup
+int main(int argc, char **argv)
+{
+    Runner runner{argc, argv};
+    const size_t n = size_t{1} << 24; //128 MB of uint64_t
+
+    runner.run("fill", "serial", "uint64", n, n,
+        [] { return sp::Vector<uint64_t>{}; },
+        [n](sp::Vector<uint64_t> &v) { sp::Vector<uint64_t>(n, 7).swap(v); });
+
+    sp::Vector<uint64_t> source(n, 3);
+    runner.run("copy", "serial", "uint64", n, n,
+        [] { return sp::Vector<uint64_t>{}; },
+        [&source](sp::Vector<uint64_t> &v) { sp::Vector<uint64_t>(source).swap(v); });
+
+    for (size_t threads = 1; threads <= 2 * sp::ThreadPool::default_threads() && threads <= 64; threads *= 2) {
+        sp::ThreadPool pool{threads};
+        const string name = "threads=" + to_string(threads);
+
+        runner.run("fill", name, "uint64", n, n,
+            [] { return sp::Vector<uint64_t>{}; },
+            [&pool, n](sp::Vector<uint64_t> &v) { v.parallel_assign(pool, n, 7); });
+
+        runner.run("generate", name, "uint64", n, n,
+            [] { return sp::Vector<uint64_t>{}; },
+            [&pool, n](sp::Vector<uint64_t> &v) {
+                v.parallel_generate(pool, n, [](size_t i) { return static_cast<uint64_t>(i) * 0x9E3779B97F4A7C15ULL; });
+            });
+
+        runner.run("copy", name, "uint64", n, n,
+            [] { return sp::Vector<uint64_t>{}; },
+            [&pool, &source](sp::Vector<uint64_t> &v) { v.parallel_assign(pool, source); });
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,77 @@
+#include "../Vector.h"
+#include "../SoAVector.h"
+#include "benchUtil.h"
+#include <cstdint>
+#include <string>
+
+using namespace std;
+using namespace sp_bench;
+
+struct Particle {
+    double x, y, z;
+    double vx, vy, vz;
+    double mass;
+    double charge;
+    uint64_t id;
+};
+
+typedef sp::SoAVector<double, double, double, double, double, double, double, double, uint64_t> Particles;
+
+//the hot loop reads 2 of the 9 fields and writes one: x += vx * dt
+int main(int argc, char **argv)
+{
+    Runner runner{argc, argv};
+    const double dt = 0.001;
+
+    for (size_t n : {size_t{1} << 12, size_t{1} << 22}) {
+        runner.run("integrate_x", "sp::Vector<Particle>", "9 fields", n, n,
+            [n] {
+                sp::Vector<Particle> v;
+                v.reserve(n);
+                for (size_t i = 0; i < n; ++i) {
+                    v.push_back(Particle{double(i), 0, 0, 1.0 / double(i + 1), 0, 0, 1, 0, i});
+                }
+                return v;
+            },
+            [dt](sp::Vector<Particle> &v) {
+                for (Particle &p : v) {
+                    p.x += p.vx * dt;
+                }
+            });
+
+        runner.run("integrate_x", "sp::SoAVector", "9 fields", n, n,
+            [n] {
+                Particles v;
+                v.reserve(n);
+                for (size_t i = 0; i < n; ++i) {
+                    v.emplace_back(double(i), 0.0, 0.0, 1.0 / double(i + 1), 0.0, 0.0, 1.0, 0.0, uint64_t{i});
+                }
+                return v;
+            },
+            [dt](Particles &v) {
+                double *x = v.data<0>();
+                const double *vx = v.data<3>();
+                for (size_t i = 0, size = v.size(); i < size; ++i) {
+                    x[i] += vx[i] * dt;
+                }
+            });
+
+        runner.run("push_back", "sp::Vector<Particle>", "9 fields", n, n,
+            [] { return sp::Vector<Particle>{}; },
+            [n](sp::Vector<Particle> &v) {
+                for (size_t i = 0; i < n; ++i) {
+                    v.push_back(Particle{double(i), 0, 0, 1, 0, 0, 1, 0, i});
+                }
+            });
+
+        runner.run("push_back", "sp::SoAVector", "9 fields", n, n,
+            [] { return Particles{}; },
+            [n](Particles &v) {
+                for (size_t i = 0; i < n; ++i) {
+                    v.emplace_back(double(i), 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, uint64_t{i});
+                }
+            });
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,130 @@
+//Created by sphc on 2026/10/19
+//benchUtil.h
+//
+
+#ifndef SP_BENCH_UTIL__H
+#define SP_BENCH_UTIL__H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace sp_bench {
+
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    { asm volatile("" : : "r,m"(value) : "memory"); }
+
+    struct Result {
+        std::string op;
+        std::string container;
+        std::string type;
+        std::size_t size;
+        double nsPerItem;
+        std::size_t iterations;
+    };
+
+    //usage: <bench> [--json file] [--filter substring] [--min-time seconds]
+    class Runner {
+    public:
+        Runner(int argc, char **argv)
+            : minTime{0.05}
+        {
+            for (int i = 1; i < argc; ++i) {
+                std::string arg = argv[i];
+                if (arg == "--json" && i + 1 < argc) {
+                    jsonPath = argv[++i];
+                }
+                else if (arg == "--filter" && i + 1 < argc) {
+                    filter = argv[++i];
+                }
+                else if (arg == "--min-time" && i + 1 < argc) {
+                    minTime = std::stod(argv[++i]);
+                }
+            }
+            std::cout << std::left << std::setw(64) << "benchmark" << std::right
+                      << std::setw(14) << "ns/item" << std::setw(12) << "iterations" << std::endl;
+        }
+
+        //setup() builds fresh state outside the timer, body(state) is timed and processes items
+        //elements; the best of the repeated runs is reported
+        template <typename Setup, typename Body>
+        void run(const std::string &op, const std::string &container, const std::string &type,
+                 std::size_t size, std::size_t items, Setup setup, Body body)
+        {
+            std::string name = key(op, container, type, size);
+            if (!filter.empty() && name.find(filter) == std::string::npos) {
+                return;
+            }
+
+            typedef std::chrono::steady_clock clock;
+            double best = 0, elapsed = 0;
+            std::size_t iterations = 0;
+            clock::time_point begin = clock::now();
+            //setup is untimed, so also bound the wall clock or cheap bodies with costly setups never end
+            while (iterations < 3
+                   || (elapsed < minTime && std::chrono::duration<double>(clock::now() - begin).count() < 4 * minTime)) {
+                auto state = setup();
+                clock::time_point t0 = clock::now();
+                body(state);
+                clock::time_point t1 = clock::now();
+                doNotOptimize(state);
+
+                double seconds = std::chrono::duration<double>(t1 - t0).count();
+                best = iterations == 0 || seconds < best ? seconds : best;
+                elapsed += seconds;
+                ++iterations;
+            }
+
+            Result result{op, container, type, size, best * 1e9 / static_cast<double>(items ? items : 1), iterations};
+            std::cout << std::left << std::setw(64) << name << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(14) << result.nsPerItem << std::setw(12) << iterations << std::endl;
+            results.push_back(result);
+        }
+
+        //writes the JSON report if --json was given, returns the process exit code
+        int finish() const
+        {
+            if (jsonPath.empty()) {
+                return 0;
+            }
+            std::ofstream out{jsonPath};
+            if (!out) {
+                std::cerr << "cannot write " << jsonPath << std::endl;
+                return 1;
+            }
+            out << "{\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                const Result &r = results[i];
+                out << "    {\"name\": \"" << key(r.op, r.container, r.type, r.size) << "\", "
+                    << "\"op\": \"" << r.op << "\", "
+                    << "\"container\": \"" << r.container << "\", "
+                    << "\"type\": \"" << r.type << "\", "
+                    << "\"size\": " << r.size << ", "
+                    << "\"ns_per_item\": " << std::setprecision(6) << r.nsPerItem << ", "
+                    << "\"iterations\": " << r.iterations << "}"
+                    << (i + 1 < results.size() ? ",\n" : "\n");
+            }
+            out << "  ]\n}\n";
+            return out ? 0 : 1;
+        }
+
+    private:
+        std::string jsonPath;
+        std::string filter;
+        double minTime;
+        std::vector<Result> results;
+
+        static std::string key(const std::string &op, const std::string &container, const std::string &type, std::size_t size)
+        { return op + "/" + container + "/" + type + "/" + std::to_string(size); }
+    };
+
+} //namespace sp_bench
+
+#endif //SP_BENCH_UTIL__H
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""Compare two benchmark JSON reports and flag regressions.
+
+usage: compareBench.py baseline.json current.json [--threshold 0.10]
+
+A benchmark regresses when its ns_per_item grows by more than the threshold
+(a fraction). Exits with status 1 if anything regressed.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {b["name"]: b for b in json.load(f)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed slowdown as a fraction (default 0.10)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    print("%-64s %12s %12s %8s" % ("benchmark", "baseline", "current", "change"))
+    for name in sorted(set(baseline) & set(current)):
+        old = baseline[name]["ns_per_item"]
+        new = current[name]["ns_per_item"]
+        change = (new - old) / old if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  improved"
+        print("%-64s %12.3f %12.3f %+7.1f%%%s" % (name, old, new, change * 100, flag))
+
+    for name in sorted(set(current) - set(baseline)):
+        print("%-64s %12s %12.3f %8s" % (name, "-", current[name]["ns_per_item"], "new"))
+    for name in sorted(set(baseline) - set(current)):
+        print("%-64s %12.3f %12s %8s" % (name, baseline[name]["ns_per_item"], "-", "gone"))
+
+    if regressions:
+        print("%d regression(s) above %.0f%%" % (regressions, args.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
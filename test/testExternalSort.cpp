@@ -0,0 +1,105 @@
+#include "../ExternalSort.h"
+#include "testUtil.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+struct Pair {
+    uint32_t key;
+    uint32_t value;
+};
+
+template <typename T>
+bool sameAs(const Vector<T> &v, const vector<T> &expect)
+{ return v.size() == expect.size() && equal(v.begin(), v.end(), expect.begin()); }
+
+int main()
+{
+    mt19937_64 rng{7};
+
+    printHead("test external sort into Vector");
+    {
+        vector<uint64_t> input;
+        for (int i = 0; i < 100000; ++i) {
+            input.push_back(rng());
+        }
+        size_t next = 0;
+        auto producer = [&](uint64_t &out) {
+            if (next == input.size()) {
+                return false;
+            }
+            out = input[next++];
+            return true;
+        };
+
+        ExternalSortOptions options;
+        options.memoryElements = 4096;
+        Vector<uint64_t> out;
+        external_sort(producer, out, options);
+        vector<uint64_t> expect = input;
+        sort(expect.begin(), expect.end());
+        check(sameAs(out, expect), "100000 elements, 4096 per run");
+
+        next = 0;
+        options.maxFanIn = 4;
+        Vector<uint64_t> multiPass;
+        external_sort(producer, multiPass, options);
+        check(sameAs(multiPass, expect), "multi-pass merge with fan-in 4");
+
+        next = 0;
+        options.memoryElements = 1 << 20;
+        Vector<uint64_t> inMemory;
+        external_sort(producer, inMemory, options, std::greater<uint64_t>{});
+        reverse(expect.begin(), expect.end());
+        check(sameAs(inMemory, expect), "fits in memory, descending");
+
+        next = input.size();
+        Vector<uint64_t> empty{1, 2, 3};
+        external_sort(producer, empty, options);
+        check(empty.empty(), "empty input");
+    }
+    printTail();
+
+    printHead("test external sort file to file");
+    {
+        string inPath = "/tmp/spExternalSortIn.bin", outPath = "/tmp/spExternalSortOut.bin";
+        vector<Pair> input;
+        for (uint32_t i = 0; i < 50000; ++i) {
+            input.push_back(Pair{static_cast<uint32_t>(rng() % 1000), i});
+        }
+        FILE *f = fopen(inPath.c_str(), "wb");
+        fwrite(input.data(), sizeof(Pair), input.size(), f);
+        fclose(f);
+
+        ExternalSortOptions options;
+        options.memoryElements = 3000;
+        auto byKey = [](const Pair &a, const Pair &b) { return a.key < b.key || (a.key == b.key && a.value < b.value); };
+        FileSource<Pair> source{inPath};
+        external_sort(source, FileSink<Pair>{outPath}, options, byKey);
+
+        vector<Pair> result(input.size() + 1);
+        f = fopen(outPath.c_str(), "rb");
+        size_t count = fread(result.data(), sizeof(Pair), result.size(), f);
+        fclose(f);
+        result.resize(count);
+        sort(input.begin(), input.end(), byKey);
+
+        bool same = result.size() == input.size();
+        for (size_t i = 0; same && i < input.size(); ++i) {
+            same = result[i].key == input[i].key && result[i].value == input[i].value;
+        }
+        check(same, "50000 pairs, 3000 per run");
+        remove(inPath.c_str());
+        remove(outPath.c_str());
+    }
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,155 @@
+#include "../FlatMap.h"
+#include "../FlatSet.h"
+#include "testUtil.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+//random bulk and single updates, checked against std::set after each step
+template <FlatSearch Search>
+bool matchesStdSet(uint32_t seed)
+{
+    mt19937 gen{seed};
+    FlatSet<int, less<int>, allocator<int>, Search> flat;
+    set<int> expect;
+    for (int round = 0; round < 30; ++round) {
+        vector<int> batch(gen() % 200);
+        for (int &x : batch) {
+            x = static_cast<int>(gen() % 1000);
+        }
+        flat.insert(batch.begin(), batch.end());
+        expect.insert(batch.begin(), batch.end());
+        int k = static_cast<int>(gen() % 1000);
+        if (flat.insert(k).second != expect.insert(k).second) {
+            return false;
+        }
+        k = static_cast<int>(gen() % 1000);
+        if (flat.erase(k) != expect.erase(k)) {
+            return false;
+        }
+        if (flat.size() != expect.size() || !equal(flat.begin(), flat.end(), expect.begin())) {
+            return false;
+        }
+        for (int q = -1; q <= 1000; ++q) {
+            if (flat.contains(q) != (expect.count(q) == 1)
+                || flat.lower_bound(q) - flat.begin() != distance(expect.begin(), expect.lower_bound(q))
+                || flat.upper_bound(q) - flat.begin() != distance(expect.begin(), expect.upper_bound(q))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    printHead("test FlatSet");
+    {
+        FlatSet<int> s{5, 1, 3, 1, 9};
+        check(s.size() == 4 && s.keys()[0] == 1 && s.keys()[3] == 9, "initializer_list sorts and dedups");
+        check(s.insert(4).second && !s.insert(4).second && *s.find(4) == 4, "single insert");
+        check(s.find(2) == s.end() && s.count(9) == 1 && s.count(10) == 0, "find and count");
+        auto range = s.equal_range(5);
+        check(range.second - range.first == 1 && *range.first == 5, "equal_range");
+        check(s.erase(3) == 1 && s.erase(3) == 0 && !s.contains(3), "erase by key");
+        check(*s.erase(s.find(4)) == 5, "erase by iterator");
+
+        FlatSet<string, greater<string>> words{"b", "a", "c"};
+        check(words.keys()[0] == "c" && words.keys()[2] == "a", "custom compare");
+
+        check(matchesStdSet<FlatSearch::binary>(1), "binary search matches std::set");
+        check(matchesStdSet<FlatSearch::branchless>(2), "branchless search matches std::set");
+        check(matchesStdSet<FlatSearch::eytzinger>(3), "eytzinger search matches std::set");
+
+        FlatSet<int, less<int>, allocator<int>, FlatSearch::eytzinger> e;
+        for (int n = 0; n < 70; ++n) {
+            e.clear();
+            vector<int> odd;
+            for (int i = 0; i < n; ++i) {
+                odd.push_back(2 * i + 1);
+            }
+            e.insert(odd.begin(), odd.end());
+            for (int q = 0; q <= 2 * n + 1; ++q) {
+                if (static_cast<int>(e.lower_bound(q) - e.begin()) != q / 2 || e.contains(q) != (q % 2 == 1 && q < 2 * n)) {
+                    n = 1000;
+                }
+            }
+        }
+        check(e.size() == 69, "eytzinger for every tree shape up to 69 keys");
+    }
+    printTail();
+
+    printHead("test FlatMap");
+    {
+        FlatMap<string, int> m{{"one", 1}, {"two", 2}, {"three", 3}, {"one", 100}};
+        check(m.size() == 3 && m.at("one") == 1, "first of repeated keys wins");
+        check(m.keys()[0] == "one" && m.keys()[1] == "three" && m.values()[1] == 3, "separate sorted arrays");
+
+        m["four"] = 4;
+        ++m["two"];
+        check(m.size() == 4 && m.at("four") == 4 && m.at("two") == 3, "operator []");
+        check(!m.insert({"four", 40}).second && m.at("four") == 4, "insert keeps present value");
+        check(!m.insert_or_assign("four", 40).second && m.at("four") == 40, "insert_or_assign");
+
+        auto it = m.find("three");
+        check(it != m.end() && it->first == "three" && (*it).second == 3, "find gives key and value");
+        it->second = 33;
+        check(m.at("three") == 33, "update through iterator");
+
+        bool threw = false;
+        try {
+            m.at("five");
+        }
+        catch (const out_of_range &) {
+            threw = true;
+        }
+        check(threw, "at throws out_of_range");
+
+        vector<pair<string, int>> more{{"zeta", 26}, {"alpha", 1}, {"one", -1}, {"alpha", -1}};
+        m.insert(more.begin(), more.end());
+        check(m.size() == 6 && m.at("alpha") == 1 && m.at("one") == 1 && m.at("zeta") == 26, "bulk insert merges");
+
+        size_t n = 0;
+        string last;
+        for (auto kv : m) {
+            check(n == 0 || last < kv.first, "iteration in key order");
+            last = kv.first;
+            ++n;
+        }
+        check(n == m.size(), "iterate every entry");
+
+        check(m.erase("zeta") == 1 && m.erase(m.cbegin())->first == "four" && m.size() == 4, "erase");
+
+        FlatMap<int, int, less<int>, allocator<pair<const int, int>>, FlatSearch::eytzinger> sym;
+        map<int, int> expect;
+        mt19937 gen{7};
+        vector<pair<int, int>> batch;
+        for (int i = 0; i < 5000; ++i) {
+            batch.emplace_back(static_cast<int>(gen() % 20000), i);
+        }
+        sym.insert(batch.begin(), batch.end());
+        expect.insert(batch.begin(), batch.end());
+        bool same = sym.size() == expect.size();
+        for (int q = 0; q < 20000 && same; ++q) {
+            auto found = sym.find(q);
+            auto want = expect.find(q);
+            same = want == expect.end() ? found == sym.end() : found != sym.end() && found->second == want->second;
+        }
+        check(same, "eytzinger map matches std::map");
+
+        FlatMap<string, int> copy = m;
+        check(copy == m, "copy compares equal");
+        copy.clear();
+        check(copy.empty() && copy != m, "clear");
+    }
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,201 @@
+#include "../HashMap.h"
+#include "../ThreadCachingAllocator.h"
+#include "testUtil.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+struct StringHash {
+    typedef void is_transparent;
+
+    size_t operator () (string_view s) const
+    { return hash<string_view>{}(s); }
+};
+
+struct StringEqual {
+    typedef void is_transparent;
+
+    bool operator () (string_view a, string_view b) const
+    { return a == b; }
+};
+
+//counts live instances, to catch leaks and double destruction
+struct Tracked {
+    static int live;
+    int value;
+
+    Tracked(int value = 0) : value{value} { ++live; }
+    Tracked(const Tracked &other) : value{other.value} { ++live; }
+    Tracked &operator = (const Tracked &other) = default;
+    ~Tracked() { --live; }
+
+    bool operator == (const Tracked &other) const
+    { return value == other.value; }
+};
+
+int Tracked::live = 0;
+
+//every hash collides in its low bits, so probing runs across many windows
+struct BadHash {
+    size_t operator () (uint64_t x) const
+    { return x & 0xff; }
+};
+
+template <typename Map>
+bool matchesStd(uint32_t seed, uint64_t keys)
+{
+    mt19937_64 gen{seed};
+    Map m;
+    unordered_map<uint64_t, uint64_t> expect;
+    for (int i = 0; i < 20000; ++i) {
+        uint64_t k = gen() % keys, op = gen() % 3;
+        if (op == 0) {
+            if (m.erase(k) != expect.erase(k)) {
+                return false;
+            }
+        }
+        else if (m.insert({k, i}).second != expect.insert({k, i}).second) {
+            return false;
+        }
+    }
+    if (m.size() != expect.size()) {
+        return false;
+    }
+    size_t seen = 0;
+    for (const auto &kv : m) {
+        auto it = expect.find(kv.first);
+        if (it == expect.end() || it->second != kv.second) {
+            return false;
+        }
+        ++seen;
+    }
+    for (uint64_t k = 0; k < keys; ++k) {
+        if (m.contains(k) != (expect.count(k) == 1)) {
+            return false;
+        }
+    }
+    return seen == expect.size();
+}
+
+int main()
+{
+    printHead("test HashMap basics");
+    {
+        HashMap<string, int> m{{"one", 1}, {"two", 2}, {"three", 3}, {"one", 100}};
+        check(m.size() == 3 && m.at("one") == 1, "first of repeated keys wins");
+        check(m.find("two") != m.end() && m.find("two")->second == 2 && m.find("four") == m.end(), "find");
+        m["four"] = 4;
+        ++m["one"];
+        check(m.size() == 4 && m.at("four") == 4 && m.at("one") == 2, "operator []");
+        check(!m.insert({"four", 40}).second && m.insert_or_assign("four", 40).first->second == 40, "insert and insert_or_assign");
+        check(m.try_emplace("five", 5).second && !m.try_emplace("five", 50).second && m.at("five") == 5, "try_emplace");
+
+        bool threw = false;
+        try {
+            m.at("six");
+        }
+        catch (const out_of_range &) {
+            threw = true;
+        }
+        check(threw, "at throws out_of_range");
+
+        check(m.erase("two") == 1 && m.erase("two") == 0 && !m.contains("two") && m.size() == 4, "erase by key");
+        size_t count = 0;
+        for (auto it = m.begin(); it != m.end(); ) {
+            it = it->second % 2 ? m.erase(it) : ++it;
+            ++count;
+        }
+        check(count == 4 && m.size() == 2 && m.contains("one") && m.contains("four"), "erase while iterating");
+
+        HashMap<string, int> copy = m;
+        check(copy == m, "copy");
+        HashMap<string, int> moved = std::move(copy);
+        check(moved == m && copy.empty() && copy.begin() == copy.end(), "move");
+        moved.clear();
+        check(moved.empty() && moved != m && !moved.contains("one"), "clear");
+        moved["again"] = 1;
+        check(moved.size() == 1, "reuse after clear");
+    }
+    printTail();
+
+    printHead("test HashMap capacity");
+    {
+        HashMap<uint64_t, uint64_t> m;
+        m.reserve(1000);
+        size_t cap = m.capacity();
+        for (uint64_t i = 0; i < 1000; ++i) {
+            m[i] = i * i;
+        }
+        check(cap >= 1000 && m.capacity() == cap, "reserve avoids rehash");
+        check(m.load_factor() <= 0.875f, "load factor at most 7/8");
+
+        //erase and insert churn must not grow a table whose size stays put
+        for (uint64_t i = 1000; i < 100000; ++i) {
+            m.erase(i - 1000);
+            m[i] = i;
+        }
+        check(m.size() == 1000 && m.capacity() == cap, "deleted markers are reclaimed in place");
+        bool values = true;
+        for (uint64_t i = 99000; i < 100000; ++i) {
+            values = values && m.at(i) == i;
+        }
+        check(values, "values after churn");
+
+        m.rehash(1 << 14);
+        check(m.capacity() == 1 << 14 && m.size() == 1000 && m.at(99999) == 99999, "rehash");
+    }
+    printTail();
+
+    printHead("test HashMap against std::unordered_map");
+    {
+        check(matchesStd<HashMap<uint64_t, uint64_t>>(1, 500), "dense keys");
+        check(matchesStd<HashMap<uint64_t, uint64_t>>(2, 1ULL << 40), "sparse keys");
+        check(matchesStd<HashMap<uint64_t, uint64_t, BadHash>>(3, 3000), "colliding hashes");
+        check(matchesStd<HashMap<uint64_t, uint64_t, hash<uint64_t>, equal_to<uint64_t>,
+                                 ThreadCachingAllocator<pair<const uint64_t, uint64_t>>>>(4, 2000), "sp allocator");
+    }
+    printTail();
+
+    printHead("test HashMap bulk and heterogeneous");
+    {
+        vector<pair<uint64_t, uint64_t>> entries;
+        for (uint64_t i = 0; i < 5000; ++i) {
+            entries.emplace_back(i * 7919 % 3001, i);
+        }
+        HashMap<uint64_t, uint64_t> bulk(entries.begin(), entries.end());
+        unordered_map<uint64_t, uint64_t> expect(entries.begin(), entries.end());
+        bool same = bulk.size() == expect.size();
+        for (const auto &kv : expect) {
+            same = same && bulk.at(kv.first) == kv.second;
+        }
+        check(same, "bulk insert keeps the first of repeated keys");
+
+        HashMap<string, int, StringHash, StringEqual> names{{"alpha", 1}, {"beta", 2}};
+        string_view key = "beta";
+        check(names.find(key) != names.end() && names.at(key) == 2 && names.contains(string_view{"alpha"})
+              && names.count(string_view{"gamma"}) == 0, "string_view lookup without a string");
+
+        {
+            HashMap<int, Tracked> tracked;
+            for (int i = 0; i < 500; ++i) {
+                tracked.try_emplace(i, i);
+            }
+            for (int i = 0; i < 500; i += 2) {
+                tracked.erase(i);
+            }
+            HashMap<int, Tracked> copy = tracked;
+            check(Tracked::live == 500, "live objects after erase and copy");
+        }
+        check(Tracked::live == 0, "every entry destroyed");
+    }
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,108 @@
+#ifndef SP_INSTRUMENTATION
+#define SP_INSTRUMENTATION 1
+#endif
+#include "../Vector.h"
+#include "../List.h"
+#include "testUtil.h"
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+static_assert(is_empty<instrument::detail::Timer<Vector<int>, false>>::value, "disabled timer must be empty");
+
+void grow(Vector<long> &v, int n)
+{
+    instrument::Site site{"grow"};
+    for (int i = 0; i < n; ++i) {
+        v.push_back(i);
+    }
+}
+
+int main()
+{
+    printHead("test Vector counters");
+    {
+        Vector<int> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        instrument::Stats s = instrument::stats<Vector<int>>();
+        cout << "allocations " << s.allocations << ", reallocations " << s.reallocations
+             << ", copies " << s.copies << ", peak " << s.peakCapacity << endl;
+        check(s.reallocations == 11 && s.allocations == 11, "one reallocation per doubling");
+        check(s.bytesAllocated == (2047 * sizeof(int)), "bytes allocated");
+        check(s.copies == 1000 + 1023 && s.moves == 0, "copies include relocation");
+        check(s.peakCapacity == 1024, "peak capacity");
+        check(s.pushBack.count() == 1000 && s.insert.count() == 0, "push_back latency samples");
+        check(s.pushBack.percentile(0.5) > 0 && s.pushBack.percentile(0.5) <= s.pushBack.percentile(1.0), "percentiles ordered");
+
+        v.insert(v.begin(), 7);
+        v.insert(v.begin() + 10, 8);
+        s = instrument::stats<Vector<int>>();
+        check(s.insert.count() == 2 && s.pushBack.count() == 1000, "insert is timed once, not as push_back");
+    }
+    instrument::Stats s = instrument::stats<Vector<int>>();
+    check(s.deallocations == s.allocations && s.bytesFreed == s.bytesAllocated, "everything freed");
+    printTail();
+
+    printHead("test List counters");
+    {
+        List<string> l;
+        for (int i = 0; i < 100; ++i) {
+            l.push_back(to_string(i));
+        }
+        string keep = "kept";
+        l.push_front(keep);
+        instrument::Stats ls = instrument::stats<List<string>>();
+        check(ls.allocations == 2 + 101 && ls.moves == 100 && ls.copies == 1, "node allocations, copies, moves");
+        check(ls.peakCapacity == 101 && ls.pushBack.count() == 100 && ls.insert.count() == 1, "peak length and latency");
+    }
+    instrument::Stats ls = instrument::stats<List<string>>();
+    check(ls.deallocations == ls.allocations, "nodes freed");
+    printTail();
+
+    printHead("test global site dump");
+    {
+        Vector<long> v;
+        grow(v, 100);
+        v.push_back(1);
+        v.shrink_to_fit();
+    }
+    map<string, uint64_t> sites = instrument::regrowth_by_site();
+    check(sites["grow"] == 8, "regrowth attributed to the site");
+    check(sites["<no site>"] >= 1, "unlabeled regrowth");
+
+    instrument::Stats g = instrument::global();
+    check(g.allocations == instrument::stats<Vector<int>>().allocations + instrument::stats<List<string>>().allocations
+                           + instrument::stats<Vector<long>>().allocations, "global is the sum of all types");
+    check(instrument::all_stats().size() == 3, "one entry per type");
+
+    ostringstream out;
+    instrument::dump(out);
+    cout << out.str();
+    check(out.str().find("sp::Vector<int") != string::npos && out.str().find("regrowth at grow: 8") != string::npos,
+          "dump names types and sites");
+
+    atomic<int> calls{0};
+    {
+        instrument::PeriodicDump periodic{chrono::milliseconds{5}, [&calls] { ++calls; }};
+        this_thread::sleep_for(chrono::milliseconds{100});
+    }
+    int seen = calls;
+    this_thread::sleep_for(chrono::milliseconds{20});
+    check(seen >= 2 && calls == seen, "periodic hook runs until destroyed");
+
+    instrument::reset();
+    g = instrument::global();
+    check(g.allocations == 0 && g.pushBack.count() == 0 && instrument::regrowth_by_site().empty(), "reset");
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,99 @@
+#include "../JaggedVector.h"
+#include "testUtil.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+template <typename T>
+bool rowIs(Span<const T> row, const vector<T> &expect)
+{ return row.size() == expect.size() && equal(row.begin(), row.end(), expect.begin()); }
+
+int main()
+{
+    printHead("test JaggedVector rows");
+    {
+        JaggedVector<uint32_t> g{{1, 2}, {}, {3, 4, 5}};
+        check(g.size() == 3 && g.element_count() == 5, "initializer_list of rows");
+        check(rowIs<uint32_t>(g[0], {1, 2}) && g[1].empty() && rowIs<uint32_t>(g[2], {3, 4, 5}), "row views");
+        Span<const size_t> off = g.offsets();
+        check(off.size() == 4 && off[0] == 0 && off[1] == 2 && off[2] == 2 && off[3] == 5, "offsets");
+
+        vector<uint32_t> more{6, 7, 8, 9};
+        g.push_back(more.begin(), more.end());
+        g.push_back(static_cast<size_t>(2), 0u);
+        g.push_back_empty();
+        g.extend_back(42);
+        g.extend_back(43);
+        check(g.size() == 6 && rowIs<uint32_t>(g[3], {6, 7, 8, 9}) && rowIs<uint32_t>(g[4], {0, 0})
+              && rowIs<uint32_t>(g.back(), {42, 43}), "push_back variants and extend_back");
+
+        g[2][1] = 40;
+        for (uint32_t &x : g[0]) {
+            x *= 10;
+        }
+        check(rowIs<uint32_t>(g[0], {10, 20}) && rowIs<uint32_t>(g[2], {3, 40, 5}), "in-place row update");
+
+        const uint32_t *before = g.elements().data();
+        g.assign_row(3, {60, 70, 80, 90});
+        check(g.elements().data() == before && rowIs<uint32_t>(g[3], {60, 70, 80, 90}), "same-length assign_row writes in place");
+
+        g.assign_row(1, {11, 12, 13});
+        check(rowIs<uint32_t>(g[1], {11, 12, 13}) && rowIs<uint32_t>(g[2], {3, 40, 5}) && rowIs<uint32_t>(g.back(), {42, 43}),
+              "longer assign_row shifts later rows only");
+        g.assign_row(3, {1});
+        check(rowIs<uint32_t>(g[3], {1}) && rowIs<uint32_t>(g[4], {0, 0}) && g.element_count() == 13,
+              "shorter assign_row");
+
+        g.pop_back();
+        check(g.size() == 5 && g.element_count() == 11, "pop_back");
+
+        size_t rows = 0, total = 0;
+        for (Span<uint32_t> row : g) {
+            ++rows;
+            total += row.size();
+        }
+        check(rows == 5 && total == 11 && g.end() - g.begin() == 5, "iterate rows");
+
+        JaggedVector<uint32_t> copy(g), moved(std::move(copy));
+        check(moved == g && copy.empty() && copy.size() == 0, "copy and move");
+        g.clear();
+        check(g.empty() && g.element_count() == 0, "clear");
+    }
+    printTail();
+
+    printHead("test JaggedVector builder");
+    {
+        //edges (from, to) in arbitrary order become adjacency lists
+        JaggedVector<uint32_t>::Builder builder{5};
+        vector<pair<uint32_t, uint32_t>> edges{{3, 1}, {0, 2}, {3, 0}, {0, 4}, {2, 3}, {0, 1}};
+        for (const auto &e : edges) {
+            builder.add(e.first, e.second);
+        }
+        JaggedVector<uint32_t> adj = builder.build();
+        check(adj.size() == 5 && adj.element_count() == 6, "rows and elements");
+        check(rowIs<uint32_t>(adj[0], {2, 4, 1}) && adj[1].empty() && rowIs<uint32_t>(adj[2], {3})
+              && rowIs<uint32_t>(adj[3], {1, 0}) && adj[4].empty(), "rows keep insertion order");
+
+        JaggedVector<string>::Builder words;
+        words.add(2, "c");
+        words.add(0, "a");
+        JaggedVector<string> w = words.build();
+        check(w.size() == 3 && w[0][0] == "a" && w[1].empty() && w[2][0] == "c", "rows grow to the largest index");
+
+        bool threw = false;
+        try {
+            w.at(3);
+        }
+        catch (const out_of_range &) {
+            threw = true;
+        }
+        check(threw, "at throws out_of_range");
+    }
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,142 @@
+#include "../List.h"
+#include "testUtil.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+template <typename T>
+void printContent(const List<T> &l, const string &op)
+{
+    cout << setw(40) << op << " | size : " << setw(2) << l.size() << " | content : ";
+    for (const auto &x : l) {
+        cout << x << " ";
+    }
+    if (l.empty()) {
+        cout << "null";
+    }
+    cout << endl;
+}
+
+template <typename T>
+bool sameAs(const List<T> &l, const vector<T> &expect)
+{
+    if (l.size() != expect.size()) {
+        return false;
+    }
+    auto j = expect.begin();
+    for (auto i = l.begin(); i != l.end(); ++i, ++j) {
+        if (!(*i == *j)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    printHead("test constructor");
+    List<int> a, b(3), c{0, 2, 4, 6, 8}, d(static_cast<List<int>::size_type>(4), 10);
+    vector<int> source{9, 8, 7};
+    List<int> e(source.begin(), source.end());
+    List<int> f(c);
+    printContent(a, "a");
+    printContent(b, "b(3)");
+    printContent(c, "c{0, 2, 4, 6, 8}");
+    printContent(d, "d(4, 10)");
+    printContent(e, "e(source.begin(), source.end())");
+    check(a.empty() && a.size() == 0, "default constructed is empty");
+    check(sameAs(b, {0, 0, 0}), "List(3)");
+    check(sameAs(d, {10, 10, 10, 10}), "List(4, 10)");
+    check(sameAs(e, {9, 8, 7}), "List(first, last)");
+    check(sameAs(f, {0, 2, 4, 6, 8}), "copy constructor");
+    printTail();
+
+    printHead("test assign move swap");
+    List<int> g(std::move(f));
+    check(sameAs(g, {0, 2, 4, 6, 8}) && f.empty(), "move constructor");
+    a = c;
+    check(sameAs(a, {0, 2, 4, 6, 8}), "copy assign");
+    b = std::move(a);
+    check(sameAs(b, {0, 2, 4, 6, 8}) && a.empty(), "move assign");
+    a = {1, 2};
+    check(sameAs(a, {1, 2}), "initializer_list assign");
+    a.assign(static_cast<List<int>::size_type>(3), 5);
+    check(sameAs(a, {5, 5, 5}), "assign(3, 5)");
+    a.swap(e);
+    check(sameAs(a, {9, 8, 7}) && sameAs(e, {5, 5, 5}), "swap");
+    printTail();
+
+    printHead("test access iterator");
+    check(c.front() == 0 && c.back() == 8, "front back");
+    vector<int> reversed;
+    for (auto it = c.rbegin(); it != c.rend(); ++it) {
+        reversed.push_back(*it);
+    }
+    check(reversed == vector<int>{8, 6, 4, 2, 0}, "rbegin rend");
+    const List<int> &cc = c;
+    int sum = 0;
+    for (auto it = cc.cbegin(); it != cc.cend(); ++it) {
+        sum += *it;
+    }
+    check(sum == 20, "cbegin cend");
+    printTail();
+
+    printHead("test update");
+    List<int> h;
+    h.push_back(2);
+    h.push_front(1);
+    h.push_back(3);
+    printContent(h, "push_front push_back");
+    check(sameAs(h, {1, 2, 3}), "push_front push_back");
+    auto it = h.insert(++h.begin(), 9);
+    check(*it == 9 && sameAs(h, {1, 9, 2, 3}), "insert");
+    h.insert(h.end(), static_cast<List<int>::size_type>(2), 4);
+    check(sameAs(h, {1, 9, 2, 3, 4, 4}), "insert(end, 2, 4)");
+    h.insert(h.begin(), {7, 8});
+    check(sameAs(h, {7, 8, 1, 9, 2, 3, 4, 4}), "insert(begin, {7, 8})");
+    h.erase(h.begin());
+    h.pop_front();
+    h.pop_back();
+    check(sameAs(h, {1, 9, 2, 3, 4}), "erase pop_front pop_back");
+    auto first = ++h.begin(), last = first;
+    ++++last;
+    h.erase(first, last);
+    check(sameAs(h, {1, 3, 4}), "erase range");
+    h.resize(5, 6);
+    check(sameAs(h, {1, 3, 4, 6, 6}), "resize(5, 6)");
+    h.resize(2);
+    check(sameAs(h, {1, 3}), "resize(2)");
+    h.clear();
+    check(h.empty(), "clear");
+    printTail();
+
+    printHead("test operation");
+    List<int> m{1, 4, 9}, n{2, 3, 10};
+    m.merge(std::move(n));
+    check(sameAs(m, {1, 2, 3, 4, 9, 10}) && n.empty(), "merge");
+    List<int> s{100, 200};
+    m.splice(++m.begin(), std::move(s));
+    check(sameAs(m, {1, 100, 200, 2, 3, 4, 9, 10}) && s.empty(), "splice whole list");
+    List<int> t{5, 6, 7};
+    m.splice(m.end(), std::move(t), ++t.begin());
+    check(sameAs(m, {1, 100, 200, 2, 3, 4, 9, 10, 6}) && sameAs(t, {5, 7}), "splice one element");
+    m.remove(100);
+    m.remove_if([](int x) { return x > 8; });
+    check(sameAs(m, {1, 2, 3, 4, 6}), "remove remove_if");
+    m.reverse();
+    check(sameAs(m, {6, 4, 3, 2, 1}), "reverse");
+    List<int> u{1, 1, 2, 2, 2, 3, 1};
+    u.unique();
+    check(sameAs(u, {1, 2, 3, 1}), "unique");
+    List<string> w{"pear", "apple", "fig", "banana"};
+    w.sort();
+    check(sameAs(w, {"apple", "banana", "fig", "pear"}), "sort");
+    w.sort([](const string &x, const string &y) { return x.size() < y.size(); });
+    check(sameAs(w, {"fig", "pear", "apple", "banana"}), "sort(comp) is stable");
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,116 @@
+#include "../MappedVector.h"
+#include "testUtil.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+int main()
+{
+    const string path = "/tmp/spMappedVectorTest.bin";
+    remove(path.c_str());
+
+    printHead("test create push_back");
+    {
+        MappedVector<uint64_t> m{path};
+        check(m.empty() && m.size() == 0, "new file is empty");
+        for (uint64_t i = 0; i < 100000; ++i) {
+            m.push_back(i * i);
+        }
+        check(m.size() == 100000, "size after 100000 push_back");
+        check(m.capacity() >= m.size(), "capacity >= size");
+        check(m[0] == 0 && m[99999] == 99999ull * 99999ull && m.back() == m[99999], "operator[] back");
+        m.pop_back();
+        check(m.size() == 99999, "pop_back");
+        m.flush();
+    }
+    printTail();
+
+    printHead("test reopen");
+    {
+        MappedVector<uint64_t> m{path, MapMode::readOnly};
+        check(m.size() == 99999 && m.capacity() == 99999, "reopened read-only, spare capacity trimmed");
+        bool same = true;
+        uint64_t i = 0;
+        for (uint64_t x : m) {
+            same = same && x == i * i;
+            ++i;
+        }
+        check(same && i == 99999, "iterate mapped contents");
+        check(*m.rbegin() == 99998ull * 99998ull, "rbegin");
+
+        bool threw = false;
+        try {
+            m.push_back(1);
+        }
+        catch (const runtime_error &) {
+            threw = true;
+        }
+        check(threw, "push_back on read-only mapping throws");
+
+        threw = false;
+        try {
+            m.at(99999);
+        }
+        catch (const out_of_range &) {
+            threw = true;
+        }
+        check(threw, "at() out of range throws");
+    }
+    printTail();
+
+    printHead("test Serialize.h interop");
+    {
+        Vector<uint64_t> v;
+        {
+            ifstream in{path, ios::binary};
+            deserialize(v, in);
+        }
+        check(v.size() == 99999 && v[12345] == 12345ull * 12345ull, "deserialize a modified mapped file");
+
+        MappedVector<uint64_t> m{path, MapMode::readOnly};
+        check(m == v && v == m && !(m != v), "MappedVector == Vector");
+
+        const string other = "/tmp/spMappedVectorTest2.bin";
+        Vector<uint64_t> w{1, 2, 3};
+        {
+            ofstream out{other, ios::binary | ios::trunc};
+            serialize(w, out);
+        }
+        MappedVector<uint64_t> mw{other};
+        check(mw == w && m < mw && mw > m && mw >= m && m <= mw, "comparisons on a serialized Vector");
+        mw.resize(5, 7);
+        check(mw.size() == 5 && mw[4] == 7, "resize grows in place");
+        mw.clear();
+        check(mw.empty(), "clear");
+        remove(other.c_str());
+
+        bool threw = false;
+        try {
+            MappedVector<uint32_t> wrong{path, MapMode::readOnly};
+        }
+        catch (const runtime_error &) {
+            threw = true;
+        }
+        check(threw, "element size mismatch throws");
+    }
+    printTail();
+
+    printHead("test move");
+    {
+        MappedVector<uint64_t> a{path};
+        MappedVector<uint64_t> b{std::move(a)};
+        check(b.size() == 99999, "move constructor");
+        b.push_back(42);
+        check(b.back() == 42, "push_back after move");
+    }
+    printTail();
+
+    remove(path.c_str());
+    return result();
+}
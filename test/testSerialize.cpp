@@ -0,0 +1,147 @@
+#include "../Serialize.h"
+#include "testUtil.h"
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+struct Point {
+    float x;
+    float y;
+    uint32_t id;
+};
+
+template <typename Container>
+bool throwsOnRead(const string &bytes)
+{
+    istringstream in{bytes};
+    Container c;
+    try {
+        deserialize(c, in);
+    }
+    catch (const runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    printHead("test Vector round trip");
+    {
+        Vector<uint64_t> v;
+        for (uint64_t i = 0; i < 100003; ++i) {
+            v.push_back(i * 2654435761u);
+        }
+        ostringstream out;
+        serialize(v, out);
+        string bytes = out.str();
+        check(bytes.size() == sizeof(SerialHeader) + v.size() * sizeof(uint64_t), "header plus payload size");
+
+        istringstream in{bytes};
+        Vector<uint64_t> w{1, 2, 3};
+        deserialize(w, in);
+        check(w == v, "deserialize(Vector<uint64_t>)");
+
+        Vector<Point> points;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            points.push_back(Point{i * 0.5f, -1.0f * i, i});
+        }
+        ostringstream pout;
+        serialize(points, pout);
+        istringstream pin{pout.str()};
+        Vector<Point> back;
+        deserialize(back, pin);
+        bool same = back.size() == points.size();
+        for (size_t i = 0; same && i < back.size(); ++i) {
+            same = back[i].x == points[i].x && back[i].y == points[i].y && back[i].id == points[i].id;
+        }
+        check(same, "deserialize(Vector<Point>)");
+
+        Vector<int> empty;
+        ostringstream eout;
+        serialize(empty, eout);
+        istringstream ein{eout.str()};
+        Vector<int> e{4, 5};
+        deserialize(e, ein);
+        check(e.empty(), "empty Vector");
+    }
+    printTail();
+
+    printHead("test List round trip");
+    {
+        List<int> l;
+        for (int i = 0; i < 5000; ++i) {
+            l.push_back(i * 7 - 100);
+        }
+        ostringstream out;
+        serialize(l, out);
+
+        istringstream in{out.str()};
+        List<int> back;
+        deserialize(back, in);
+        bool same = back.size() == l.size();
+        for (auto i = l.begin(), j = back.begin(); same && i != l.end(); ++i, ++j) {
+            same = *i == *j;
+        }
+        check(same, "deserialize(List<int>)");
+
+        istringstream asVector{out.str()};
+        Vector<int> v;
+        deserialize(v, asVector);
+        check(v.size() == 5000 && v[0] == -100 && v[4999] == 4999 * 7 - 100, "List file read as Vector");
+    }
+    printTail();
+
+    printHead("test ChunkReader");
+    {
+        Vector<uint32_t> v;
+        for (uint32_t i = 0; i < 10007; ++i) {
+            v.push_back(i ^ 0x5a5a);
+        }
+        ostringstream out;
+        serialize(v, out);
+
+        istringstream in{out.str()};
+        ChunkReader<uint32_t> reader{in};
+        check(reader.size() == v.size(), "size() from header");
+        Vector<uint32_t> chunk, all;
+        size_t chunks = 0;
+        while (!reader.done()) {
+            reader.next(chunk, 1000);
+            for (uint32_t x : chunk) {
+                all.push_back(x);
+            }
+            ++chunks;
+        }
+        check(chunks == 11, "11 chunks of at most 1000");
+        check(all == v, "chunks reassemble the payload");
+        check(reader.next(chunk, 1000) == 0 && chunk.empty(), "next() after the end");
+    }
+    printTail();
+
+    printHead("test corrupt input");
+    {
+        Vector<uint64_t> v{1, 2, 3, 4, 5};
+        ostringstream out;
+        serialize(v, out);
+        string bytes = out.str();
+
+        string flipped = bytes;
+        flipped[sizeof(SerialHeader) + 3] ^= 1;
+        check(throwsOnRead<Vector<uint64_t>>(flipped), "payload bit flip");
+        check(throwsOnRead<Vector<uint64_t>>(bytes.substr(0, bytes.size() - 1)), "truncated payload");
+        check(throwsOnRead<Vector<uint64_t>>(bytes.substr(0, 10)), "truncated header");
+        check(throwsOnRead<Vector<uint32_t>>(bytes), "element size mismatch");
+        string badMagic = bytes;
+        badMagic[0] = 'X';
+        check(throwsOnRead<List<uint64_t>>(badMagic), "bad magic");
+    }
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,158 @@
+#include "../SoAVector.h"
+#include "testUtil.h"
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+int liveFields = 0;
+
+struct Fragile {
+    static int copiesLeft;
+    int value;
+
+    Fragile(int v = 0) : value{v}
+    { ++liveFields; }
+
+    Fragile(const Fragile &other) : value{other.value}
+    {
+        if (copiesLeft-- == 0) {
+            throw runtime_error{"copy failed"};
+        }
+        ++liveFields;
+    }
+
+    Fragile &operator = (const Fragile &) = default;
+
+    ~Fragile()
+    { --liveFields; }
+
+    bool operator == (const Fragile &other) const
+    { return value == other.value; }
+};
+
+int Fragile::copiesLeft = 1 << 30;
+
+int main()
+{
+    typedef SoAVector<float, double, string> Table;
+
+    printHead("test SoAVector basics");
+    {
+        Table t;
+        for (int i = 0; i < 1000; ++i) {
+            t.push_back(Table::value_type{float(i), i * 0.5, to_string(i)});
+        }
+        t.emplace_back(1.5f, 2.5, "last");
+        check(t.size() == 1001 && t.capacity() >= 1001, "push_back emplace_back");
+        check(t[10].get<0>() == 10.0f && t[10].get<1>() == 5.0 && t[10].get<2>() == "10", "row proxy get");
+        check(t.back() == Table::value_type{1.5f, 2.5, "last"}, "row compares with value_type");
+
+        bool aligned = reinterpret_cast<uintptr_t>(t.data<0>()) % 64 == 0 && reinterpret_cast<uintptr_t>(t.data<1>()) % 64 == 0
+                       && reinterpret_cast<uintptr_t>(t.data<2>()) % 64 == 0;
+        check(aligned, "columns are 64-byte aligned");
+
+        Span<double> halves = t.column<1>();
+        double sum = accumulate(halves.begin(), halves.end(), 0.0);
+        check(halves.size() == 1001 && sum == 999.0 * 1000 / 4 + 2.5, "column span");
+
+        auto [f, d, s] = t[3];
+        f = 30.0f;
+        s = "three";
+        check(t[3].get<0>() == 30.0f && t[3].get<2>() == "three" && d == 1.5, "structured bindings are references");
+
+        t[4] = Table::value_type{4.5f, 9.0, "four"};
+        t[5] = t[4];
+        check(t[5].get<2>() == "four" && t[5].get<1>() == 9.0, "assignment through the proxy");
+
+        Table::value_type copied = t[6];
+        check(get<2>(copied) == "6", "row converts to value_type");
+
+        const Table &ct = t;
+        int count = 0;
+        for (auto row : ct) {
+            count += row.get<2>().empty() ? 0 : 1;
+        }
+        check(count == 1001 && ct.end() - ct.begin() == 1001, "iteration");
+
+        bool threw = false;
+        try {
+            t.at(5000);
+        }
+        catch (const out_of_range &) {
+            threw = true;
+        }
+        check(threw, "at throws out_of_range");
+    }
+    printTail();
+
+    printHead("test SoAVector update");
+    {
+        SoAVector<int, string> t{{1, "a"}, {2, "b"}, {3, "c"}};
+        t.insert(t.begin() + 1, {9, "z"});
+        t.emplace(t.begin(), 0, "first");
+        check(t.size() == 5 && t[0].get<1>() == "first" && t[2].get<0>() == 9 && t[2].get<1>() == "z"
+              && t[4].get<1>() == "c", "insert and emplace keep columns in lockstep");
+        t.erase(t.begin() + 1, t.begin() + 3);
+        check(t.size() == 3 && t[0].get<0>() == 0 && t[1].get<1>() == "b" && t[2].get<0>() == 3, "erase range");
+        t.erase(t.begin());
+        t.pop_back();
+        check(t.size() == 1 && t[0] == make_tuple(2, string{"b"}), "erase pop_back");
+
+        t.resize(4, 7, "seven");
+        check(t.size() == 4 && t[3].get<1>() == "seven", "resize with values");
+        t.resize(2);
+        t.shrink_to_fit();
+        check(t.size() == 2 && t.capacity() == 2, "shrink_to_fit");
+
+        SoAVector<int, string> u(t), w;
+        w = t;
+        check(u == t && w == t, "copy");
+        SoAVector<int, string> m(std::move(u));
+        check(m == t && u.empty(), "move");
+        m.clear();
+        check(m.empty() && m.capacity() == 2, "clear keeps capacity");
+    }
+    printTail();
+
+    printHead("test SoAVector exception safety");
+    {
+        {
+            SoAVector<int, Fragile> t;
+            for (int i = 0; i < 8; ++i) {
+                t.emplace_back(i, Fragile{i});
+            }
+            Fragile::copiesLeft = 3;
+            bool threw = false;
+            try {
+                t.push_back(make_tuple(8, Fragile{8}));
+                t.reserve(100);
+            }
+            catch (const runtime_error &) {
+                threw = true;
+            }
+            Fragile::copiesLeft = 1 << 30;
+            check(threw && t.size() == 8 && t.capacity() == 8 && t[7].get<1>().value == 7, "failed growth keeps contents");
+
+            Fragile::copiesLeft = 0;
+            threw = false;
+            try {
+                t.push_back(make_tuple(9, Fragile{9}));
+            }
+            catch (const runtime_error &) {
+                threw = true;
+            }
+            Fragile::copiesLeft = 1 << 30;
+            check(threw && t.size() == 8, "failed row construction leaves no half row");
+        }
+        check(liveFields == 0, "no leaked or double destroyed fields");
+    }
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,165 @@
+#include "../Sort.h"
+#include "testUtil.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+struct Record {
+    uint32_t key;
+    int order;
+    string payload;
+};
+
+template <typename T>
+bool sameAs(const Vector<T> &v, const vector<T> &expect)
+{ return v.size() == expect.size() && equal(v.begin(), v.end(), expect.begin()); }
+
+template <typename T, typename Gen>
+void fill(Vector<T> &v, vector<T> &copy, size_t n, Gen gen)
+{
+    v.clear();
+    copy.clear();
+    for (size_t i = 0; i < n; ++i) {
+        T x = gen(i);
+        v.push_back(x);
+        copy.push_back(x);
+    }
+}
+
+int main()
+{
+    mt19937_64 rng{42};
+    const size_t sizes[] = {0, 1, 2, 23, 24, 255, 256, 1000, 100000};
+
+    printHead("test radix sort integral");
+    for (size_t n : sizes) {
+        Vector<uint64_t> v;
+        vector<uint64_t> expect;
+        fill(v, expect, n, [&](size_t) { return rng(); });
+        sort(v);
+        std::sort(expect.begin(), expect.end());
+        check(sameAs(v, expect), "sort(Vector<uint64_t>) n = " + to_string(n));
+    }
+    for (size_t n : sizes) {
+        Vector<int32_t> v;
+        vector<int32_t> expect;
+        fill(v, expect, n, [&](size_t) { return static_cast<int32_t>(rng()); });
+        sort(v, std::greater<int32_t>{});
+        std::sort(expect.begin(), expect.end(), std::greater<int32_t>{});
+        check(sameAs(v, expect), "sort(Vector<int32_t>, greater) n = " + to_string(n));
+    }
+    {
+        Vector<int16_t> v;
+        vector<int16_t> expect;
+        fill(v, expect, 5000, [&](size_t) { return static_cast<int16_t>(rng() % 7 - 3); });
+        radix_sort(v);
+        std::sort(expect.begin(), expect.end());
+        check(sameAs(v, expect), "radix_sort(Vector<int16_t>) with duplicates");
+    }
+    printTail();
+
+    printHead("test radix sort floating point");
+    {
+        Vector<double> v;
+        vector<double> expect;
+        uniform_real_distribution<double> dist{-1e6, 1e6};
+        fill(v, expect, 10000, [&](size_t i) { return i % 100 == 0 ? -0.0 : dist(rng); });
+        sort(v);
+        std::sort(expect.begin(), expect.end());
+        check(is_sorted(v.begin(), v.end()), "sort(Vector<double>) ordered");
+        check(v.size() == expect.size(), "sort(Vector<double>) size kept");
+    }
+    {
+        Vector<float> v;
+        vector<float> expect;
+        uniform_real_distribution<float> dist{-100.0f, 100.0f};
+        fill(v, expect, 3000, [&](size_t) { return dist(rng); });
+        sort(v, std::greater<float>{});
+        std::sort(expect.begin(), expect.end(), std::greater<float>{});
+        check(sameAs(v, expect), "sort(Vector<float>, greater)");
+    }
+    printTail();
+
+    printHead("test radix sort with key extractor");
+    {
+        Vector<Record> v;
+        for (int i = 0; i < 20000; ++i) {
+            v.push_back(Record{static_cast<uint32_t>(rng() % 1000), i, to_string(i)});
+        }
+        radix_sort(v, [](const Record &r) { return r.key; });
+        bool ordered = true, stable = true, intact = true;
+        for (size_t i = 1; i < v.size(); ++i) {
+            ordered = ordered && v[i - 1].key <= v[i].key;
+            stable = stable && (v[i - 1].key != v[i].key || v[i - 1].order < v[i].order);
+        }
+        for (size_t i = 0; i < v.size(); ++i) {
+            intact = intact && v[i].payload == to_string(v[i].order);
+        }
+        check(ordered, "radix_sort(Vector<Record>, key) ordered");
+        check(stable, "radix_sort(Vector<Record>, key) stable");
+        check(intact, "radix_sort(Vector<Record>, key) payload moved");
+    }
+    printTail();
+
+    printHead("test introsort");
+    {
+        const char *names[] = {"random", "sorted", "reversed", "organ pipe", "few unique", "sawtooth"};
+        for (int pattern = 0; pattern < 6; ++pattern) {
+            for (size_t n : sizes) {
+                Vector<string> v;
+                vector<string> expect;
+                fill(v, expect, n, [&](size_t i) -> string {
+                    switch (pattern) {
+                    case 0: return to_string(rng());
+                    case 1: return to_string(1000000 + i);
+                    case 2: return to_string(1000000 - i);
+                    case 3: return to_string(1000000 + (i < n / 2 ? i : n - i));
+                    case 4: return to_string(rng() % 4);
+                    default: return to_string(1000000 + i % 37);
+                    }
+                });
+                sort(v);
+                std::sort(expect.begin(), expect.end());
+                check(sameAs(v, expect), string("sort(Vector<string>) ") + names[pattern] + " n = " + to_string(n));
+            }
+        }
+        Vector<int> v;
+        vector<int> expect;
+        fill(v, expect, 50000, [&](size_t) { return static_cast<int>(rng() % 100000); });
+        sort(v, [](int a, int b) { return a % 1000 < b % 1000 || (a % 1000 == b % 1000 && a < b); });
+        std::sort(expect.begin(), expect.end(), [](int a, int b) { return a % 1000 < b % 1000 || (a % 1000 == b % 1000 && a < b); });
+        check(sameAs(v, expect), "sort(Vector<int>, lambda)");
+    }
+    printTail();
+
+    printHead("test stable sort");
+    {
+        Vector<Record> v;
+        vector<Record> expect;
+        fill(v, expect, 12345, [&](size_t i) { return Record{static_cast<uint32_t>(rng() % 50), static_cast<int>(i), to_string(i)}; });
+        auto byKey = [](const Record &a, const Record &b) { return a.key < b.key; };
+        stable_sort(v, byKey);
+        std::stable_sort(expect.begin(), expect.end(), byKey);
+        bool same = v.size() == expect.size();
+        for (size_t i = 0; same && i < v.size(); ++i) {
+            same = v[i].order == expect[i].order && v[i].payload == expect[i].payload;
+        }
+        check(same, "stable_sort(Vector<Record>, comp)");
+
+        Vector<double> d;
+        vector<double> expectD;
+        fill(d, expectD, 1000, [&](size_t) { return static_cast<double>(rng() % 300); });
+        stable_sort(d);
+        std::sort(expectD.begin(), expectD.end());
+        check(sameAs(d, expectD), "stable_sort(Vector<double>)");
+    }
+    printTail();
+
+    return result();
+}
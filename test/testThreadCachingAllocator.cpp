@@ -0,0 +1,161 @@
+#include "../ThreadCachingAllocator.h"
+#include "../Vector.h"
+#include "../List.h"
+#include "testUtil.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+template <typename T>
+using TVector = Vector<T, ThreadCachingAllocator<T>>;
+
+template <typename T>
+using TList = List<T, ThreadCachingAllocator<T>>;
+
+struct alignas(64) Wide {
+    char bytes[64];
+};
+
+bool sizeClassesCover()
+{
+    for (size_t bytes = 1; bytes <= detail::maxCachedBytes; ++bytes) {
+        size_t index = detail::size_class(bytes);
+        if (index >= detail::sizeClasses || detail::class_bytes(index) < bytes
+            || (index && detail::class_bytes(index - 1) >= bytes) || detail::class_bytes(index) % 16) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    printHead("test size classes");
+    check(sizeClassesCover(), "every size maps to the smallest fitting class");
+    check(detail::class_bytes(detail::sizeClasses - 1) == detail::maxCachedBytes, "largest class");
+    printTail();
+
+    printHead("test containers");
+    {
+        TVector<uint64_t> v;
+        for (uint64_t i = 0; i < 100000; ++i) {
+            v.push_back(i * 3);
+        }
+        bool ok = true;
+        for (uint64_t i = 0; i < v.size(); ++i) {
+            ok = ok && v[i] == i * 3;
+        }
+        check(ok && v.size() == 100000, "Vector grows through small and large requests");
+
+        TList<string> l;
+        for (int i = 0; i < 1000; ++i) {
+            l.push_back("node-" + to_string(i));
+        }
+        l.sort([](const string &a, const string &b) { return a > b; });
+        check(l.size() == 1000 && l.front() == "node-999" && l.back() == "node-0", "List allocates nodes through it");
+
+        TList<string> m(l);
+        l.clear();
+        check(m.size() == 1000 && l.empty(), "copy and clear");
+
+        ThreadCachingAllocator<int> a;
+        ThreadCachingAllocator<double> b{a};
+        check(a == b && !(a != b), "all instances are equal");
+
+        ThreadCachingAllocator<Wide> wide;
+        Wide *w = wide.allocate(3);
+        check(reinterpret_cast<uintptr_t>(w) % 64 == 0, "over-aligned types keep their alignment");
+        wide.deallocate(w, 3);
+
+        ThreadCachingAllocator<char> bytes;
+        set<char *> live;
+        bool distinct = true;
+        for (int i = 0; i < 5000; ++i) {
+            char *p = bytes.allocate(24);
+            distinct = distinct && live.insert(p).second && reinterpret_cast<uintptr_t>(p) % 16 == 0;
+        }
+        check(distinct, "live blocks are distinct and 16-byte aligned");
+        for (char *p : live) {
+            bytes.deallocate(p, 24);
+        }
+    }
+    printTail();
+
+    printHead("test cross thread frees");
+    {
+        //producers allocate, consumers free: blocks must flow back through the central lists
+        const int producers = 4, items = 20000;
+        mutex queueMutex;
+        condition_variable ready;
+        deque<TVector<int> *> queue;
+        atomic<int> done{0};
+        atomic<long> checked{0};
+        atomic<bool> corrupt{false};
+
+        vector<thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (int i = 0; i < items; ++i) {
+                    TVector<int> *v = new TVector<int>;
+                    for (int k = 0; k < 1 + (i % 40); ++k) {
+                        v->push_back(p * items + i);
+                    }
+                    lock_guard<mutex> lock{queueMutex};
+                    queue.push_back(v);
+                    ready.notify_one();
+                }
+                ++done;
+                ready.notify_all();
+            });
+        }
+        for (int c = 0; c < 2; ++c) {
+            threads.emplace_back([&] {
+                for (;;) {
+                    unique_lock<mutex> lock{queueMutex};
+                    ready.wait(lock, [&] { return !queue.empty() || done == producers; });
+                    if (queue.empty()) {
+                        return;
+                    }
+                    TVector<int> *v = queue.front();
+                    queue.pop_front();
+                    lock.unlock();
+                    for (int x : *v) {
+                        if (x != v->front()) {
+                            corrupt = true;
+                        }
+                    }
+                    ++checked;
+                    delete v;
+                }
+            });
+        }
+        for (thread &t : threads) {
+            t.join();
+        }
+        check(checked == producers * items && !corrupt, "every buffer arrives intact and is freed remotely");
+
+        thread worker([] {
+            TList<int> l;
+            for (int i = 0; i < 10000; ++i) {
+                l.push_back(i);
+            }
+            thread_cache_flush();
+        });
+        worker.join();
+        TList<int> reuse(static_cast<TList<int>::size_type>(10000), 1);
+        check(reuse.size() == 10000, "memory cached by exited threads is reused");
+    }
+    printTail();
+
+    return result();
+}
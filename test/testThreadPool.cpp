@@ -0,0 +1,156 @@
+#include "../ThreadPool.h"
+#include "../Vector.h"
+#include "testUtil.h"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+atomic<long> liveTracked{0};
+
+//throws while being copied once armed, to check that partial parallel fills clean up
+struct Tracked {
+    static atomic<long> copiesLeft;
+    uint64_t value;
+
+    explicit Tracked(uint64_t v = 0) : value{v}
+    { ++liveTracked; }
+
+    Tracked(const Tracked &other) : value{other.value}
+    {
+        if (copiesLeft.fetch_sub(1) == 0) {
+            throw runtime_error{"copy failed"};
+        }
+        ++liveTracked;
+    }
+
+    ~Tracked()
+    { --liveTracked; }
+};
+
+atomic<long> Tracked::copiesLeft{1L << 40};
+
+int main()
+{
+    ThreadPool pool{4};
+
+    printHead("test ThreadPool");
+    {
+        atomic<uint64_t> sum{0};
+        pool.parallel_for(0, 100000, [&sum](size_t i) { sum += i; });
+        check(sum == 100000ull * 99999 / 2, "parallel_for visits every index once");
+
+        atomic<int> inner{0};
+        pool.parallel_for(0, 8, [&pool, &inner](size_t) {
+            pool.parallel_for(0, 100, [&inner](size_t) { ++inner; });
+        });
+        check(inner == 800, "nested parallel_for");
+
+        atomic<int> ran{0};
+        bool thrown = false;
+        try {
+            pool.parallel_for(0, 1000, [&ran](size_t i) {
+                ++ran;
+                if (i == 500) {
+                    throw runtime_error{"boom"};
+                }
+            });
+        }
+        catch (const runtime_error &) {
+            thrown = true;
+        }
+        check(thrown && ran >= 1, "exception reaches the caller");
+
+        atomic<int> submitted{0};
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&submitted] { ++submitted; });
+        }
+        pool.parallel_for(0, 1, [](size_t) { });
+        while (submitted != 100) {
+            this_thread::yield();
+        }
+        check(submitted == 100 && pool.size() == 4, "submit");
+    }
+    printTail();
+
+    printHead("test Vector parallel fill");
+    {
+        Vector<int> v;
+        v.parallel_assign(pool, 3000000, 7);
+        bool ok = v.size() == 3000000 && v.capacity() == 3000000;
+        for (int x : v) {
+            ok = ok && x == 7;
+        }
+        check(ok, "parallel_assign(count, value)");
+
+        atomic<size_t> calls{0};
+        Vector<uint64_t> g;
+        g.parallel_generate(pool, 1000003, [&calls](size_t i) {
+            ++calls;
+            return static_cast<uint64_t>(i) * i;
+        });
+        ok = g.size() == 1000003 && calls == 1000003;
+        for (size_t i = 0; i < g.size(); ++i) {
+            ok = ok && g[i] == static_cast<uint64_t>(i) * i;
+        }
+        check(ok, "parallel_generate");
+
+        Vector<string> source;
+        for (int i = 0; i < 200000; ++i) {
+            source.push_back("string-" + to_string(i) + "-long-enough-to-allocate");
+        }
+        Vector<string> copy;
+        copy.push_back("old");
+        copy.parallel_assign(pool, source);
+        check(copy == source, "parallel_assign(other) copies strings");
+
+        v.parallel_resize(pool, 5000000, 9);
+        ok = v.size() == 5000000 && v[2999999] == 7 && v[3000000] == 9 && v[4999999] == 9;
+        v.reserve(6000000);
+        v.parallel_resize(pool, 6000000, 1);
+        ok = ok && v.size() == 6000000 && v[4999999] == 9 && v[5000000] == 1 && v[5999999] == 1;
+        v.parallel_resize(pool, 10, 0);
+        check(ok && v.size() == 10 && v[9] == 7, "parallel_resize grows, fills spare capacity and shrinks");
+
+        Vector<int> empty;
+        empty.parallel_assign(pool, 0, 1);
+        check(empty.empty(), "empty fill");
+    }
+    printTail();
+
+    printHead("test parallel fill exception safety");
+    {
+        Vector<Tracked> v;
+        v.parallel_assign(pool, 300000, Tracked{5});
+        long before = liveTracked;
+        Tracked::copiesLeft = 250000;
+        bool thrown = false;
+        try {
+            Vector<Tracked> w;
+            w.parallel_assign(pool, v);
+        }
+        catch (const runtime_error &) {
+            thrown = true;
+        }
+        Tracked::copiesLeft = 1L << 40;
+        check(thrown && liveTracked == before, "every element built before the throw is destroyed");
+
+        Tracked::copiesLeft = 100000;
+        thrown = false;
+        try {
+            v.parallel_resize(pool, 600000, Tracked{6});
+        }
+        catch (const runtime_error &) {
+            thrown = true;
+        }
+        Tracked::copiesLeft = 1L << 40;
+        check(thrown && liveTracked == before && v.size() == 300000 && v[0].value == 5, "failed resize leaves the Vector unchanged");
+    }
+    printTail();
+
+    return result();
+}
@@ -0,0 +1,58 @@
+//Created by sphc on 2026/10/19
+//testUtil.h
+//
+
+#ifndef SP_TEST_UTIL__H
+#define SP_TEST_UTIL__H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+namespace sp_test {
+
+    inline int &symbolCount()
+    {
+        static int count;
+        return count;
+    }
+
+    inline int &failures()
+    {
+        static int count;
+        return count;
+    }
+
+    inline void printHead(const std::string &title)
+    {
+        std::string::size_type count = 140 - title.size();
+
+        symbolCount() = count / 2;
+        std::string s(symbolCount(), '=');
+        symbolCount() = symbolCount() * 2 + title.size();
+        std::cout << s << title << s << std::endl;
+    }
+
+    inline void printTail()
+    { std::cout << std::string(symbolCount(), '=') << std::endl; }
+
+    inline void check(bool ok, const std::string &what)
+    {
+        std::cout << std::setw(60) << what << " : " << (ok ? "ok" : "FAILED") << std::endl;
+        if (!ok) {
+            ++failures();
+        }
+    }
+
+    //exit status for main
+    inline int result()
+    {
+        if (failures()) {
+            std::cout << failures() << " check(s) failed" << std::endl;
+        }
+        return failures() ? 1 : 0;
+    }
+
+} //namespace sp_test
+
+#endif //SP_TEST_UTIL__H
@@ -0,0 +1,126 @@
+#include "../Vector.h"
+#include "testUtil.h"
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace sp;
+using namespace sp_test;
+
+int main()
+{
+    const string path = "/tmp/spVectorIOTest.bin";
+
+    printHead("test append_from_fd regular file");
+    {
+        Vector<uint32_t> source;
+        for (uint32_t i = 0; i < 300000; ++i) {
+            source.push_back(i * 3);
+        }
+        FILE *f = fopen(path.c_str(), "wb");
+        fwrite(source.data(), sizeof(uint32_t), source.size(), f);
+        fclose(f);
+
+        int fd = open(path.c_str(), O_RDONLY);
+        Vector<uint32_t> v{7};
+        Vector<uint32_t>::size_type count = v.append_from_fd(fd, static_cast<Vector<uint32_t>::size_type>(-1), true);
+        check(count == source.size(), "appended every element");
+        check(v.size() == source.size() + 1 && v[0] == 7 && v[1] == 0 && v.back() == 299999u * 3, "appended after existing content");
+        check(v.capacity() == v.size(), "regular file sized the buffer exactly");
+        check(v.append_from_fd(fd) == 0, "nothing left at end of file");
+        close(fd);
+
+        fd = open(path.c_str(), O_RDONLY);
+        Vector<uint32_t> limited;
+        check(limited.append_from_fd(fd, 4003) == 1000 && limited[999] == 2997, "max_bytes rounds down to whole elements");
+        check(limited.append_from_fd(fd, 8) == 2 && limited[1001] == 3003, "continues from the file offset");
+        close(fd);
+
+        fd = open(path.c_str(), O_RDONLY);
+        Vector<uint32_t> exact;
+        exact.read_exact(fd, 10);
+        check(exact.size() == 10 && exact[9] == 27, "read_exact(fd, 10)");
+        bool threw = false;
+        try {
+            exact.read_exact(fd, 300000);
+        }
+        catch (const runtime_error &) {
+            threw = true;
+        }
+        check(threw && exact.size() == 10, "read_exact past end of file throws and keeps size");
+        close(fd);
+    }
+    printTail();
+
+    printHead("test append_from_fd pipe");
+    {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return 1;
+        }
+        thread writer([&] {
+            for (uint64_t i = 0; i < 100000; ++i) {
+                ssize_t n = write(fds[1], &i, sizeof(i));
+                (void)n;
+            }
+            close(fds[1]);
+        });
+        Vector<uint64_t> v;
+        v.append_from_fd(fds[0]);
+        writer.join();
+        close(fds[0]);
+
+        bool same = v.size() == 100000;
+        for (uint64_t i = 0; same && i < v.size(); ++i) {
+            same = v[i] == i;
+        }
+        check(same, "100000 elements through a pipe");
+
+        if (pipe(fds) != 0) {
+            return 1;
+        }
+        char odd[5] = {1, 2, 3, 4, 5};
+        ssize_t n = write(fds[1], odd, sizeof(odd));
+        (void)n;
+        close(fds[1]);
+        Vector<uint32_t> partial{1};
+        bool threw = false;
+        try {
+            partial.append_from_fd(fds[0]);
+        }
+        catch (const runtime_error &) {
+            threw = true;
+        }
+        close(fds[0]);
+        check(threw && partial.size() == 1, "trailing partial element throws and rolls back");
+    }
+    printTail();
+
+    printHead("test append_from istream");
+    {
+        string bytes;
+        for (uint16_t i = 0; i < 50000; ++i) {
+            bytes.append(reinterpret_cast<const char *>(&i), sizeof(i));
+        }
+        istringstream in{bytes};
+        Vector<uint16_t> v;
+        check(v.append_from(in) == 50000 && v[49999] == 49999, "append_from(istringstream)");
+        check(in.eof(), "stream at eof");
+
+        istringstream again{bytes};
+        Vector<uint16_t> w;
+        w.read_exact(again, 3);
+        check(w.size() == 3 && w[2] == 2, "read_exact(istream, 3)");
+        check(w.append_from(again, 10) == 5 && w[7] == 7, "append_from(istream, 10 bytes)");
+    }
+    printTail();
+
+    remove(path.c_str());
+    return result();
+}